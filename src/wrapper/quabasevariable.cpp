@@ -14,7 +14,6 @@ void QUaBaseVariable::onWrite(UA_Server             *server,
 {
 	Q_UNUSED(sessionContext);
 	Q_UNUSED(nodeId);
-	Q_UNUSED(range);
 	// get variable from context
 #ifdef QT_DEBUG 
 	auto var = qobject_cast<QUaBaseVariable*>(static_cast<QObject*>(nodeContext));
@@ -41,19 +40,34 @@ void QUaBaseVariable::onWrite(UA_Server             *server,
 	// NOTE : sometimes happens that !srv->m_hashSessions.contains(*sessionId)
 	srv->m_currentSession = srv->m_hashSessions.contains(*sessionId) ?
 		srv->m_hashSessions[*sessionId] : nullptr;
+	// batched writes are internal too
+	bool networkChange = !var->m_bInternalWrite && !srv->m_updateCommitting;
+	// keep attribute cache coherent, read from server on next getter call if incomplete
+	var->m_cacheValueValid = !range && data->hasSourceTimestamp && data->hasServerTimestamp;
+	if (var->m_cacheValueValid)
+	{
+		// NOTE : timestamp setters alternate hasStatus but keep status, so ignore the flag
+		var->m_cacheStatusCode      = data->status;
+		var->m_cacheSourceTimestamp = data->sourceTimestamp;
+		var->m_cacheServerTimestamp = data->serverTimestamp;
+	}
 	// do not process if nobody listening
 	static const QMetaMethod valueSignal = QMetaMethod::fromSignal(&QUaBaseVariable::valueChanged);
 	if (var->isSignalConnected(valueSignal))
 	{
+		// convert written value directly, only read back from node if partial or no value written
+		QVariant value = data->hasValue && !range ?
+			QUaTypesConverter::uaVariantToQVariant(data->value) :
+			var->value();
 		// emit value changed
-		emit var->valueChanged(var->value(), !var->m_bInternalWrite);
+		emit var->valueChanged(value, networkChange);
 	}
 	// do not process if nobody listening
 	static const QMetaMethod statusSignal = QMetaMethod::fromSignal(&QUaBaseVariable::statusCodeChanged);
 	if (data->hasStatus && var->isSignalConnected(statusSignal))
 	{
 		// emit status changed
-		emit var->statusCodeChanged(QUaStatusCode(data->status), !var->m_bInternalWrite);
+		emit var->statusCodeChanged(QUaStatusCode(data->status), networkChange);
 	}
 	// do not process if nobody listening
 	static const QMetaMethod sourceSignal = QMetaMethod::fromSignal(&QUaBaseVariable::sourceTimestampChanged);
@@ -63,7 +77,7 @@ void QUaBaseVariable::onWrite(UA_Server             *server,
 		emit var->sourceTimestampChanged(
 			QUaTypesConverter::uaVariantToQVariantScalar
 				<QDateTime, UA_DateTime>(&data->sourceTimestamp), 
-			!var->m_bInternalWrite
+			networkChange
 		);
 	}
 	// do not process if nobody listening
@@ -74,7 +88,7 @@ void QUaBaseVariable::onWrite(UA_Server             *server,
 		emit var->serverTimestampChanged(
 			QUaTypesConverter::uaVariantToQVariantScalar
 				<QDateTime, UA_DateTime>(&data->serverTimestamp),
-			!var->m_bInternalWrite
+			networkChange
 		);
 	}
 	var->m_bInternalWrite = false;
@@ -122,8 +136,16 @@ void QUaBaseVariable::onRead(
 		return;
 	}
 	if (!var->m_readCallback || var->m_readCallbackRunning) return;
+	// serve stored value if last result still valid, no callback and no write
+	if (var->m_readCallbackMaxAge > 0 &&
+		var->m_readCallbackTimer.isValid() &&
+		!var->m_readCallbackTimer.hasExpired(var->m_readCallbackMaxAge))
+	{
+		return;
+	}
 	// setValue (somehow) triggers read callback again; this avoids recursion
 	QVariant newValue = var->m_readCallback();
+	var->m_readCallbackTimer.start();
 	if (!newValue.isNull())
 	{
 		var->m_readCallbackRunning = true;
@@ -132,6 +154,164 @@ void QUaBaseVariable::onRead(
 	}
 }
 
+#ifdef UA_ENABLE_SUBSCRIPTIONS
+// [STATIC]
+void QUaBaseVariable::onMonitoredItemRegister(
+	UA_Server       *server, 
+	const UA_NodeId *sessionId, 
+	void            *sessionContext, 
+	const UA_NodeId *nodeId, 
+	void            *nodeContext, 
+	UA_UInt32        attributeId, 
+	UA_Boolean       removed)
+{
+	Q_UNUSED(sessionId);
+	Q_UNUSED(sessionContext);
+	// only value monitoring is relevant for producers
+	if (attributeId != UA_ATTRIBUTEID_VALUE)
+	{
+		return;
+	}
+	QUaServer* srv = QUaServer::getServerNodeContext(server);
+	Q_CHECK_PTR(srv);
+	// NOTE : called for all nodes, context is null if node was already deleted
+	auto var = qobject_cast<QUaBaseVariable*>(static_cast<QObject*>(nodeContext));
+	// or if not instantiated yet, then instantiate to keep count
+	if (!var && !removed && srv->m_lazyInstantiation)
+	{
+		var = qobject_cast<QUaBaseVariable*>(srv->nodeById(*nodeId));
+	}
+	if (!var)
+	{
+		return;
+	}
+	bool wasMonitored = var->m_monitoredItemsCount > 0;
+	var->m_monitoredItemsCount += removed ? -1 : 1;
+	Q_ASSERT(var->m_monitoredItemsCount >= 0);
+	var->m_monitoredItemsCount = (std::max)(0, var->m_monitoredItemsCount);
+	bool isMonitored = var->m_monitoredItemsCount > 0;
+	if (wasMonitored != isMonitored)
+	{
+		emit var->monitoredChanged(isMonitored);
+	}
+}
+#endif // UA_ENABLE_SUBSCRIPTIONS
+
+// [STATIC]
+UA_StatusCode QUaBaseVariable::onSourceRead(
+	UA_Server             *server, 
+	const UA_NodeId       *sessionId, 
+	void                  *sessionContext, 
+	const UA_NodeId       *nodeId, 
+	void                  *nodeContext, 
+	UA_Boolean             includeSourceTimeStamp, 
+	const UA_NumericRange *range, 
+	UA_DataValue          *value)
+{
+	Q_UNUSED(server);
+	Q_UNUSED(sessionId);
+	Q_UNUSED(sessionContext);
+	Q_UNUSED(nodeId);
+	// NOTE : can be called from network thread, only bound members are accessed
+	auto var = static_cast<QUaBaseVariable*>(nodeContext);
+	if (!var || !var->m_sourceData)
+	{
+		return UA_STATUSCODE_BADINTERNALERROR;
+	}
+	// point variant to bound memory, server encodes directly from it
+	UA_Variant source;
+	if (var->m_sourceSize < 0)
+	{
+		UA_Variant_setScalar(&source, var->m_sourceData, var->m_sourceType);
+	}
+	else
+	{
+		UA_Variant_setArray(&source, var->m_sourceData, static_cast<size_t>(var->m_sourceSize), var->m_sourceType);
+	}
+	source.storageType = UA_VARIANT_DATA_NODELETE;
+	// partial read needs its own copy
+	if (range)
+	{
+		auto st = UA_Variant_copyRange(&source, &value->value, *range);
+		if (st != UA_STATUSCODE_GOOD)
+		{
+			return st;
+		}
+	}
+	else
+	{
+		value->value = source;
+	}
+	value->hasValue = true;
+	if (includeSourceTimeStamp)
+	{
+		value->sourceTimestamp    = var->m_sourceTimestamp;
+		value->hasSourceTimestamp = true;
+	}
+	return UA_STATUSCODE_GOOD;
+}
+
+// [STATIC]
+UA_StatusCode QUaBaseVariable::onSourceWrite(
+	UA_Server             *server, 
+	const UA_NodeId       *sessionId, 
+	void                  *sessionContext, 
+	const UA_NodeId       *nodeId, 
+	void                  *nodeContext, 
+	const UA_NumericRange *range, 
+	const UA_DataValue    *value)
+{
+	auto var = static_cast<QUaBaseVariable*>(nodeContext);
+	if (!var || !var->m_sourceData)
+	{
+		return UA_STATUSCODE_BADINTERNALERROR;
+	}
+	if (!var->m_sourceWritable)
+	{
+		return UA_STATUSCODE_BADNOTWRITABLE;
+	}
+	// only whole value writes with same shape are supported
+	if (range || !value->hasValue)
+	{
+		return UA_STATUSCODE_BADWRITENOTSUPPORTED;
+	}
+	const UA_Variant &newValue = value->value;
+	bool isScalar = var->m_sourceSize < 0;
+	if (UA_Variant_isScalar(&newValue) != isScalar ||
+		(!isScalar && newValue.arrayLength != static_cast<size_t>(var->m_sourceSize)))
+	{
+		return UA_STATUSCODE_BADTYPEMISMATCH;
+	}
+	// client must write the bound type, numeric conversion could silently truncate
+	if (newValue.type != var->m_sourceType)
+	{
+		return UA_STATUSCODE_BADTYPEMISMATCH;
+	}
+	if (!QUaTypesConverter::uaNumericArrayCopy(
+		newValue.data, 
+		newValue.type, 
+		var->m_sourceData, 
+		var->m_sourceType, 
+		isScalar ? 1 : static_cast<size_t>(var->m_sourceSize)))
+	{
+		return UA_STATUSCODE_BADTYPEMISMATCH;
+	}
+	UA_DateTime now = UA_DateTime_now();
+	var->m_sourceTimestamp = value->hasSourceTimestamp ? 
+		value->sourceTimestamp : now;
+	// NOTE : client values often lack timestamps, stamp them as the server would for
+	//        stored values so onWrite caches them (shallow copy, variant not owned)
+	UA_DataValue stamped = *value;
+	stamped.sourceTimestamp    = var->m_sourceTimestamp;
+	stamped.hasSourceTimestamp = true;
+	stamped.serverTimestamp    = now;
+	stamped.hasServerTimestamp = true;
+	// emit signals same as stored values
+	QUaBaseVariable::onWrite(server, sessionId, sessionContext, 
+		nodeId, nodeContext, range, &stamped);
+	return UA_STATUSCODE_GOOD;
+}
+
 QUaBaseVariable::QUaBaseVariable(
 	QUaServer* server
 ) : QUaNode(server)
@@ -147,11 +327,32 @@ QUaBaseVariable::QUaBaseVariable(
 	//    const UA_NodeId &nodeId = *server->m_newNodeNodeId;
 	// sets also write callback to emit onWrite signal
 	setReadCallback();
+	m_deadbandType  = QUaDeadbandType::None;
+	m_updateBatch   = 0;
+	m_updateWrite   = -1;
+	m_deadbandValue = 0.0;
+	m_readCallbackMaxAge  = 0;
+	m_monitoredItemsCount = 0;
+	m_cacheValueValid = false;
+	m_cacheSourceTimestamp = 0;
+	m_cacheServerTimestamp = 0;
+	m_cacheAttrValid  = false;
+	m_sourceData      = nullptr;
+	m_sourceType      = nullptr;
+	m_sourceSize      = -1;
+	m_sourceWritable  = false;
+	m_sourceTimestamp = 0;
 #ifdef UA_ENABLE_HISTORIZING
 	m_maxHistoryDataResponseSize = 1000;
 #endif // UA_ENABLE_HISTORIZING
 }
 
+QUaBaseVariable::~QUaBaseVariable()
+{
+	// unregister from polling scheduler (no-op if not polled)
+	m_qUaServer->removePolledVariable(this);
+}
+
 void QUaBaseVariable::setReadCallback(const std::function<QVariant()>& readCallback){
 	UA_ValueCallback callback;
 	if (readCallback)
@@ -166,10 +367,23 @@ void QUaBaseVariable::setReadCallback(const std::function<QVariant()>& readCallb
 		m_readCallback = readCallback;
 	}
 	callback.onWrite = &QUaBaseVariable::onWrite;
+	// new callback, discard last result
+	m_readCallbackTimer.invalidate();
 	// this replaces the previous callback, if any
 	UA_Server_setVariableNode_valueCallback(m_qUaServer->m_server, m_nodeId, callback);
 }
 
+qint64 QUaBaseVariable::readCallbackMaxAge() const
+{
+	return m_readCallbackMaxAge;
+}
+
+void QUaBaseVariable::setReadCallbackMaxAge(const qint64& maxAge)
+{
+	Q_ASSERT(maxAge >= 0);
+	m_readCallbackMaxAge = (std::max)(static_cast<qint64>(0), maxAge);
+}
+
 QVariant QUaBaseVariable::value() const
 {
 	return this->getValueInternal();
@@ -274,6 +488,28 @@ void QUaBaseVariable::setValue(
 			}
 		}
 	}
+	// batch update, writes are applied on QUaServer::commitUpdate
+	if (m_qUaServer->m_updateDepth > 0)
+	{
+		// convert once for both deadband and write
+		auto uaVar = QUaTypesConverter::uaVariantFromQVariant(newValue);
+		// drop update if within deadband
+		if (newType == oldType && this->isInDeadband(uaVar, statusCode))
+		{
+			UA_Variant_clear(&uaVar);
+			return;
+		}
+		this->addUpdateWrites(
+			uaVar, 
+			statusCode, 
+			sourceTimestamp, 
+			serverTimestamp, 
+			newType != oldType ? newType : QMetaType::UnknownType
+		);
+		// update cache
+		m_dataType = newType;
+		return;
+	}
 	// wether new type is forced or could not be converted to old type, we need type convertion
 	if (newType != oldType)
 	{
@@ -286,6 +522,12 @@ void QUaBaseVariable::setValue(
 	}
 	// convert to UA_Variant and set new value
 	auto uaVar = QUaTypesConverter::uaVariantFromQVariant(newValue);
+	// drop update if within deadband
+	if (newType == oldType && this->isInDeadband(uaVar, statusCode))
+	{
+		UA_Variant_clear(&uaVar);
+		return;
+	}
 	// mask as internal write to avoid emitting valueChange signal on QUaBaseVariable::onWrite
 	m_bInternalWrite = true;
 	auto st = this->setValueInternal(
@@ -316,19 +558,11 @@ void QUaBaseVariable::setValue(
 
 QDateTime QUaBaseVariable::sourceTimestamp() const
 {
-	UA_ReadValueId rv;
-	UA_ReadValueId_init(&rv);
-	rv.nodeId      = m_nodeId;
-	rv.attributeId = UA_ATTRIBUTEID_VALUE;
-	UA_DataValue value = UA_Server_read(
-		m_qUaServer->m_server,
-		&rv,
-		UA_TIMESTAMPSTORETURN_SOURCE
-	);
-	QDateTime time = QUaTypesConverter::uaVariantToQVariantScalar<QDateTime, UA_DateTime>(&value.sourceTimestamp);
-	// clean up
-	UA_DataValue_clear(&value);
-	return time;
+	if (!m_cacheValueValid)
+	{
+		this->updateValueCache();
+	}
+	return QUaTypesConverter::uaVariantToQVariantScalar<QDateTime, UA_DateTime>(&m_cacheSourceTimestamp);
 }
 
 void QUaBaseVariable::setSourceTimestamp(const QDateTime& sourceTimestamp)
@@ -374,19 +608,11 @@ void QUaBaseVariable::setSourceTimestamp(const QDateTime& sourceTimestamp)
 
 QDateTime QUaBaseVariable::serverTimestamp() const
 {
-	UA_ReadValueId rv;
-	UA_ReadValueId_init(&rv);
-	rv.nodeId      = m_nodeId;
-	rv.attributeId = UA_ATTRIBUTEID_VALUE;
-	UA_DataValue value = UA_Server_read(
-		m_qUaServer->m_server,
-		&rv,
-		UA_TIMESTAMPSTORETURN_SERVER
-	);
-	QDateTime time = QUaTypesConverter::uaVariantToQVariantScalar<QDateTime, UA_DateTime>(&value.serverTimestamp);
-	// clean up
-	UA_DataValue_clear(&value);
-	return time;
+	if (!m_cacheValueValid)
+	{
+		this->updateValueCache();
+	}
+	return QUaTypesConverter::uaVariantToQVariantScalar<QDateTime, UA_DateTime>(&m_cacheServerTimestamp);
 }
 
 void QUaBaseVariable::setServerTimestamp(const QDateTime& serverTimestamp)
@@ -431,6 +657,15 @@ void QUaBaseVariable::setServerTimestamp(const QDateTime& serverTimestamp)
 }
 
 QUaStatusCode QUaBaseVariable::statusCode() const
+{
+	if (!m_cacheValueValid)
+	{
+		this->updateValueCache();
+	}
+	return m_cacheStatusCode;
+}
+
+void QUaBaseVariable::updateValueCache() const
 {
 	UA_ReadValueId rv;
 	UA_ReadValueId_init(&rv);
@@ -439,12 +674,58 @@ QUaStatusCode QUaBaseVariable::statusCode() const
 	UA_DataValue value = UA_Server_read(
 		m_qUaServer->m_server,
 		&rv,
-		UA_TIMESTAMPSTORETURN_SERVER
+		UA_TIMESTAMPSTORETURN_BOTH
 	);
-	QUaStatusCode statusCode = value.status;
+	m_cacheStatusCode      = value.status;
+	m_cacheSourceTimestamp = value.sourceTimestamp;
+	m_cacheServerTimestamp = value.serverTimestamp;
+	m_cacheValueValid      = true;
 	// clean up
 	UA_DataValue_clear(&value);
-	return statusCode;
+}
+
+void QUaBaseVariable::updateAttributeCache() const
+{
+	Q_CHECK_PTR(m_qUaServer);
+	Q_ASSERT(!UA_NodeId_isNull(&m_nodeId));
+	UA_Server * server = m_qUaServer->m_server;
+	// attributes writable by clients are not cached
+	UA_UInt32 outWriteMask;
+	auto st = UA_Server_readWriteMask(server, m_nodeId, &outWriteMask);
+	Q_ASSERT(st == UA_STATUSCODE_GOOD);
+	m_cacheWriteMask = outWriteMask;
+	// read valueRank
+	st = UA_Server_readValueRank(server, m_nodeId, &m_cacheValueRank);
+	Q_ASSERT(st == UA_STATUSCODE_GOOD);
+	// read arrayDimensions
+	UA_Variant outArrayDimensions;
+	st = UA_Server_readArrayDimensions(server, m_nodeId, &outArrayDimensions);
+	Q_ASSERT(st == UA_STATUSCODE_GOOD);
+	// convert UA_Variant to QVector<quint32>
+	m_cacheArrayDimensions.clear();
+	Q_ASSERT(UA_Variant_isEmpty(&outArrayDimensions) || outArrayDimensions.type == &UA_TYPES[UA_TYPES_UINT32]);
+	auto data = static_cast<quint32*>(outArrayDimensions.data);
+	for (int i = 0; i < (int)outArrayDimensions.arrayLength; i++)
+	{
+		m_cacheArrayDimensions.append(data[i]);
+	}
+	UA_Variant_clear(&outArrayDimensions);
+	// read accessLevel
+	st = UA_Server_readAccessLevel(server, m_nodeId, &m_cacheAccessLevel);
+	Q_ASSERT(st == UA_STATUSCODE_GOOD);
+	// read minimumSamplingInterval
+	st = UA_Server_readMinimumSamplingInterval(server, m_nodeId, &m_cacheMinimumSamplingInterval);
+	Q_ASSERT(st == UA_STATUSCODE_GOOD);
+	Q_UNUSED(st);
+	m_cacheAttrValid = true;
+}
+
+void QUaBaseVariable::setWriteMask(const quint32& writeMask)
+{
+	// call base implementation
+	QUaNode::setWriteMask(writeMask);
+	// re-read attributes, some might now be writable by clients
+	m_cacheAttrValid = false;
 }
 
 void QUaBaseVariable::setStatusCode(const QUaStatusCode& statusCode)
@@ -700,6 +981,532 @@ UA_StatusCode QUaBaseVariable::setValueInternal(
 {
 	// set value
 	UA_WriteValue wv;
+	this->initWriteValue(wv, value, status, sourceTimestamp, serverTimestamp);
+	auto st = UA_Server_write(m_qUaServer->m_server, &wv);
+	Q_ASSERT(st == UA_STATUSCODE_GOOD);
+	return st;
+}
+
+void QUaBaseVariable::addUpdateWrites(
+	UA_Variant            &value,
+	const UA_StatusCode   &status,
+	const QDateTime       &sourceTimestamp,
+	const QDateTime       &serverTimestamp,
+	const QMetaType::Type &newDataType)
+{
+	UA_WriteValue wv;
+	// need to set type to UA_NS0ID_BASEDATATYPE to avoid "BadTypeMismatch" error
+	if (newDataType != QMetaType::UnknownType)
+	{
+		this->initWriteDataType(wv, UA_NODEID_NUMERIC(0, UA_NS0ID_BASEDATATYPE));
+		m_qUaServer->addUpdateWrite(wv);
+	}
+	// NOTE : server takes ownership of value
+	this->initWriteValue(wv, value, status, sourceTimestamp, serverTimestamp);
+	// remember pending value, so deadband compares against it within the batch
+	m_updateBatch = m_qUaServer->m_updateBatch;
+	m_updateWrite = m_qUaServer->m_updateWrites.count();
+	m_qUaServer->addUpdateWrite(wv);
+	UA_Variant_init(&value);
+	// set new type after value
+	if (newDataType != QMetaType::UnknownType)
+	{
+		this->initWriteDataType(wv, QUaTypesConverter::uaTypeNodeIdFromQType(newDataType));
+		m_qUaServer->addUpdateWrite(wv);
+	}
+}
+
+void QUaBaseVariable::setValueDirect(
+	UA_Variant          &value,
+	const UA_StatusCode &status,
+	const QDateTime     &sourceTimestamp,
+	const QDateTime     &serverTimestamp)
+{
+	Q_CHECK_PTR(m_qUaServer);
+	Q_ASSERT(!UA_NodeId_isNull(&m_nodeId));
+	// drop update if within deadband
+	if (this->isInDeadband(value, status))
+	{
+		UA_Variant_clear(&value);
+		return;
+	}
+	// batch update, server takes ownership of value
+	if (m_qUaServer->m_updateDepth > 0)
+	{
+		this->addUpdateWrites(value, status, sourceTimestamp, serverTimestamp, QMetaType::UnknownType);
+		return;
+	}
+	// mask as internal write to avoid emitting valueChange signal on QUaBaseVariable::onWrite
+	m_bInternalWrite = true;
+	auto st = this->setValueInternal(
+		value,
+		status,
+		sourceTimestamp,
+		serverTimestamp
+	);
+	Q_ASSERT(st == UA_STATUSCODE_GOOD);
+	Q_UNUSED(st);
+	// clean up
+	UA_Variant_clear(&value);
+}
+
+bool QUaBaseVariable::setValueArrayInternal(
+	const void          *data,
+	const int           &size,
+	const UA_DataType   *type,
+	const UA_StatusCode &status,
+	const QDateTime     &sourceTimestamp,
+	const QDateTime     &serverTimestamp)
+{
+	Q_ASSERT(size >= 0);
+	// check current type supported
+	const UA_DataType * nodeType = m_dataType != QMetaType::UnknownType ?
+		QUaTypesConverter::uaTypeFromQType(m_dataType) : nullptr;
+	if (!QUaTypesConverter::isArithmeticType(nodeType))
+	{
+		return false;
+	}
+	UA_Variant uaVar;
+	UA_Variant_init(&uaVar);
+	// NOTE : empty array as in QUaTypesConverter::uaVariantFromQVariantArray
+	if (size > 0)
+	{
+		void * arr = UA_Array_new(static_cast<size_t>(size), nodeType);
+		auto ok = QUaTypesConverter::uaNumericArrayCopy(
+			data, type, arr, nodeType, static_cast<size_t>(size)
+		);
+		Q_ASSERT(ok);
+		Q_UNUSED(ok);
+		UA_Variant_setArray(&uaVar, arr, static_cast<size_t>(size), nodeType);
+		QUaTypesConverter::uaVariantSetArrayDimensions(uaVar, static_cast<size_t>(size));
+	}
+	this->setValueDirect(
+		uaVar,
+		status,
+		sourceTimestamp,
+		serverTimestamp
+	);
+	return true;
+}
+
+int QUaBaseVariable::valueArrayInternal(
+	void              *buffer,
+	const int         &maxSize,
+	const UA_DataType *type) const
+{
+	Q_CHECK_PTR(m_qUaServer);
+	Q_ASSERT(!UA_NodeId_isNull(&m_nodeId));
+	Q_ASSERT(maxSize >= 0);
+	// bound to external memory, copy from it directly
+	if (m_sourceData)
+	{
+		size_t size = m_sourceSize < 0 ? 1 : static_cast<size_t>(m_sourceSize);
+		size = qMin(size, static_cast<size_t>(maxSize));
+		return QUaTypesConverter::uaNumericArrayCopy(
+			m_sourceData, m_sourceType, buffer, type, size) ? static_cast<int>(size) : -1;
+	}
+	UA_Server * server = m_qUaServer->m_server;
+	int count = -1;
+#if UA_MULTITHREADING >= 100
+	UA_LOCK(server->serviceMutex);
+#endif // UA_MULTITHREADING
+	// access stored value directly to avoid copying whole data value
+	auto node = reinterpret_cast<const UA_VariableNode*>(UA_NODESTORE_GET(server, &m_nodeId));
+	if (node && 
+		node->nodeClass   == UA_NODECLASS_VARIABLE && 
+		node->valueSource == UA_VALUESOURCE_DATA)
+	{
+		const UA_Variant &value = node->value.data.value.value;
+		if (UA_Variant_isEmpty(&value))
+		{
+			count = 0;
+		}
+		else
+		{
+			size_t size = UA_Variant_isScalar(&value) ? 1 : value.arrayLength;
+			size = qMin(size, static_cast<size_t>(maxSize));
+			if (QUaTypesConverter::uaNumericArrayCopy(
+				value.data, value.type, buffer, type, size))
+			{
+				count = static_cast<int>(size);
+			}
+		}
+	}
+	if (node)
+	{
+		UA_NODESTORE_RELEASE(server, reinterpret_cast<const UA_Node*>(node));
+	}
+#if UA_MULTITHREADING >= 100
+	UA_UNLOCK(server->serviceMutex);
+#endif // UA_MULTITHREADING
+	return count;
+}
+
+void QUaBaseVariable::setValueSourceInternal(
+	void              *data, 
+	const UA_DataType *type, 
+	const int         &size, 
+	const bool        &writable)
+{
+	Q_CHECK_PTR(m_qUaServer);
+	Q_ASSERT(!UA_NodeId_isNull(&m_nodeId));
+	Q_CHECK_PTR(data);
+	Q_CHECK_PTR(type);
+	if (!data || !type)
+	{
+		return;
+	}
+	// rebinding must keep the memory type, clients and cache rely on it
+	if (m_sourceData && m_sourceType != type)
+	{
+		Q_ASSERT_X(false, "QUaBaseVariable::setValueSource", "Cannot rebind with a different type.");
+		return;
+	}
+	// data type must match memory, set before binding
+	auto dataType = QUaTypesConverter::uaTypeToQType(type);
+	if (!m_sourceData)
+	{
+		this->setDataType(dataType);
+	}
+	Q_ASSERT(m_dataType == dataType);
+	m_sourceData      = data;
+	m_sourceType      = type;
+	m_sourceSize      = size;
+	m_sourceWritable  = writable;
+	m_sourceTimestamp = UA_DateTime_now();
+	// replaces stored value and value callbacks
+	UA_DataSource dataSource;
+	dataSource.read  = &QUaBaseVariable::onSourceRead;
+	dataSource.write = &QUaBaseVariable::onSourceWrite;
+	auto st = UA_Server_setVariableNode_dataSource(m_qUaServer->m_server, m_nodeId, dataSource);
+	Q_ASSERT(st == UA_STATUSCODE_GOOD);
+	Q_UNUSED(st);
+	m_cacheValueValid = false;
+}
+
+static UA_StatusCode restoreValueData(
+	UA_Server  *server,
+	UA_Session *session,
+	UA_Node    *node,
+	void       *data)
+{
+	Q_UNUSED(server);
+	Q_UNUSED(session);
+	Q_UNUSED(data);
+	if (node->nodeClass != UA_NODECLASS_VARIABLE)
+	{
+		return UA_STATUSCODE_BADNODECLASSINVALID;
+	}
+	auto varNode = reinterpret_cast<UA_VariableNode*>(node);
+	if (varNode->valueSource == UA_VALUESOURCE_DATA)
+	{
+		return UA_STATUSCODE_GOOD;
+	}
+	// NOTE : data source overlaps stored value in union, so init all
+	varNode->valueSource = UA_VALUESOURCE_DATA;
+	UA_DataValue_init(&varNode->value.data.value);
+	varNode->value.data.callback.onRead  = nullptr;
+	varNode->value.data.callback.onWrite = nullptr;
+	return UA_STATUSCODE_GOOD;
+}
+
+void QUaBaseVariable::clearValueSource()
+{
+	Q_CHECK_PTR(m_qUaServer);
+	Q_ASSERT(!UA_NodeId_isNull(&m_nodeId));
+	if (!m_sourceData)
+	{
+		return;
+	}
+	// copy current memory contents
+	UA_Variant uaVar;
+	UA_Variant_init(&uaVar);
+	auto st = m_sourceSize < 0 ?
+		UA_Variant_setScalarCopy(&uaVar, m_sourceData, m_sourceType) :
+		UA_Variant_setArrayCopy(&uaVar, m_sourceData, static_cast<size_t>(m_sourceSize), m_sourceType);
+	Q_ASSERT(st == UA_STATUSCODE_GOOD);
+	QDateTime sourceTimestamp = QUaTypesConverter::uaVariantToQVariantScalar<QDateTime, UA_DateTime>(&m_sourceTimestamp);
+	m_sourceData = nullptr;
+	// switch back to stored value
+	UA_Server * server = m_qUaServer->m_server;
+#if UA_MULTITHREADING >= 100
+	UA_LOCK(server->serviceMutex);
+#endif // UA_MULTITHREADING
+	st = UA_Server_editNode(server, &server->adminSession, &m_nodeId, &restoreValueData, nullptr);
+#if UA_MULTITHREADING >= 100
+	UA_UNLOCK(server->serviceMutex);
+#endif // UA_MULTITHREADING
+	Q_ASSERT(st == UA_STATUSCODE_GOOD);
+	Q_UNUSED(st);
+	// restore value callbacks
+	this->setReadCallback(m_readCallback);
+	// set copied contents as stored value
+	m_bInternalWrite = true;
+	st = this->setValueInternal(uaVar, UA_STATUSCODE_GOOD, sourceTimestamp);
+	Q_ASSERT(st == UA_STATUSCODE_GOOD);
+	UA_Variant_clear(&uaVar);
+	m_cacheValueValid = false;
+}
+
+bool QUaBaseVariable::hasValueSource() const
+{
+	return m_sourceData != nullptr;
+}
+
+void QUaBaseVariable::setValueSourceChanged(const QDateTime& sourceTimestamp)
+{
+	Q_ASSERT(m_sourceData);
+	if (!m_sourceData)
+	{
+		return;
+	}
+	QUaTypesConverter::uaVariantFromQVariantScalar(
+		sourceTimestamp.isValid() ? sourceTimestamp : QDateTime::currentDateTimeUtc(), 
+		&m_sourceTimestamp
+	);
+	m_cacheValueValid = false;
+	// do not process if nobody listening
+	static const QMetaMethod valueSignal = QMetaMethod::fromSignal(&QUaBaseVariable::valueChanged);
+	if (this->isSignalConnected(valueSignal))
+	{
+		emit this->valueChanged(this->value(), false);
+	}
+	static const QMetaMethod sourceSignal = QMetaMethod::fromSignal(&QUaBaseVariable::sourceTimestampChanged);
+	if (this->isSignalConnected(sourceSignal))
+	{
+		emit this->sourceTimestampChanged(this->sourceTimestamp(), false);
+	}
+}
+
+bool QUaBaseVariable::isMonitored() const
+{
+	return m_monitoredItemsCount > 0;
+}
+
+int QUaBaseVariable::monitoredItemsCount() const
+{
+	return m_monitoredItemsCount;
+}
+
+double QUaBaseVariable::monitoredSamplingInterval() const
+{
+	double fastest = -1.0;
+#ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
+	if (m_monitoredItemsCount <= 0)
+	{
+		return fastest;
+	}
+	UA_Server * server = m_qUaServer->m_server;
+#if UA_MULTITHREADING >= 100
+	UA_LOCK(server->serviceMutex);
+#endif // UA_MULTITHREADING
+	// loop monitored items of all subscriptions of all sessions
+	for (auto sessionId = m_qUaServer->m_hashSessions.keyBegin(); 
+		sessionId != m_qUaServer->m_hashSessions.keyEnd(); ++sessionId)
+	{
+		UA_Session * session = UA_Server_getSessionById(server, &(*sessionId));
+		if (!session)
+		{
+			continue;
+		}
+		UA_Subscription * subscription = NULL;
+		LIST_FOREACH(subscription, &session->serverSubscriptions, listEntry)
+		{
+			UA_MonitoredItem * monitoredItem = NULL;
+			LIST_FOREACH(monitoredItem, &subscription->monitoredItems, listEntry)
+			{
+				if (monitoredItem->attributeId    != UA_ATTRIBUTEID_VALUE ||
+					monitoredItem->monitoringMode == UA_MONITORINGMODE_DISABLED ||
+					!UA_NodeId_equal(&monitoredItem->monitoredNodeId, &m_nodeId))
+				{
+					continue;
+				}
+				fastest = fastest < 0.0 ? monitoredItem->samplingInterval :
+					(std::min)(fastest, monitoredItem->samplingInterval);
+			}
+		}
+	}
+#if UA_MULTITHREADING >= 100
+	UA_UNLOCK(server->serviceMutex);
+#endif // UA_MULTITHREADING
+#endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
+	return fastest;
+}
+
+QUaDeadbandType QUaBaseVariable::deadbandType() const
+{
+	return m_deadbandType;
+}
+
+void QUaBaseVariable::setDeadbandType(const QUaDeadbandType& deadbandType)
+{
+	m_deadbandType = deadbandType;
+}
+
+double QUaBaseVariable::deadbandValue() const
+{
+	return m_deadbandValue;
+}
+
+void QUaBaseVariable::setDeadbandValue(const double& deadbandValue)
+{
+	Q_ASSERT(deadbandValue >= 0.0);
+	m_deadbandValue = qMax(deadbandValue, 0.0);
+}
+
+bool QUaBaseVariable::isInDeadband(
+	const UA_Variant    &value,
+	const UA_StatusCode &status)
+{
+	if (m_deadbandType == QUaDeadbandType::None ||
+		!QUaTypesConverter::isNumericType(value.type))
+	{
+		return false;
+	}
+	double band = m_deadbandValue;
+	if (m_deadbandType == QUaDeadbandType::Percent)
+	{
+		double low, high;
+		// percent deadband requires EURange
+		if (!this->euRange(low, high))
+		{
+			return false;
+		}
+		band = (m_deadbandValue / 100.0) * qAbs(high - low);
+	}
+	// within a batch compare against pending value, stored value is outdated
+	if (m_updateWrite >= 0 && m_updateBatch == m_qUaServer->m_updateBatch)
+	{
+		const UA_WriteValue &pending = m_qUaServer->m_updateWrites.at(m_updateWrite);
+		return QUaBaseVariable::isInDeadband(pending.value, value, status, band);
+	}
+	UA_Server * server = m_qUaServer->m_server;
+	bool inBand = false;
+#if UA_MULTITHREADING >= 100
+	UA_LOCK(server->serviceMutex);
+#endif // UA_MULTITHREADING
+	// compare against stored value directly to avoid copying whole data value
+	auto node = reinterpret_cast<const UA_VariableNode*>(UA_NODESTORE_GET(server, &m_nodeId));
+	if (node &&
+		node->nodeClass   == UA_NODECLASS_VARIABLE &&
+		node->valueSource == UA_VALUESOURCE_DATA)
+	{
+		inBand = QUaBaseVariable::isInDeadband(node->value.data.value, value, status, band);
+	}
+	if (node)
+	{
+		UA_NODESTORE_RELEASE(server, reinterpret_cast<const UA_Node*>(node));
+	}
+#if UA_MULTITHREADING >= 100
+	UA_UNLOCK(server->serviceMutex);
+#endif // UA_MULTITHREADING
+	return inBand;
+}
+
+bool QUaBaseVariable::isInDeadband(
+	const UA_DataValue  &oldValue,
+	const UA_Variant    &value,
+	const UA_StatusCode &status,
+	const double        &band)
+{
+	// NOTE : hasStatus alternated by timestamp setters, status is always kept
+	if (!oldValue.hasValue ||
+		oldValue.status != status ||
+		oldValue.value.type != value.type ||
+		UA_Variant_isScalar(&oldValue.value) != UA_Variant_isScalar(&value) ||
+		oldValue.value.arrayLength != value.arrayLength)
+	{
+		return false;
+	}
+	size_t size = UA_Variant_isScalar(&value) ? 1 : value.arrayLength;
+	auto oldData = static_cast<const UA_Byte*>(oldValue.value.data);
+	auto newData = static_cast<const UA_Byte*>(value.data);
+	for (size_t i = 0; i < size; i++)
+	{
+		double oldElem, newElem;
+		QUaTypesConverter::uaNumericArrayCopy(oldData + i * value.type->memSize, value.type,
+			&oldElem, &UA_TYPES[UA_TYPES_DOUBLE], 1);
+		QUaTypesConverter::uaNumericArrayCopy(newData + i * value.type->memSize, value.type,
+			&newElem, &UA_TYPES[UA_TYPES_DOUBLE], 1);
+		if (qAbs(newElem - oldElem) > band)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool QUaBaseVariable::euRange(double& low, double& high)
+{
+	// cache property, browse again if deleted
+	if (!m_euRange)
+	{
+		m_euRange = this->browseChild<QUaBaseVariable>("EURange");
+		if (!m_euRange)
+		{
+			return false;
+		}
+	}
+	UA_Server * server = m_qUaServer->m_server;
+	bool ok = false;
+#if UA_MULTITHREADING >= 100
+	UA_LOCK(server->serviceMutex);
+#endif // UA_MULTITHREADING
+	auto node = reinterpret_cast<const UA_VariableNode*>(UA_NODESTORE_GET(server, &m_euRange->m_nodeId));
+	if (node &&
+		node->nodeClass   == UA_NODECLASS_VARIABLE &&
+		node->valueSource == UA_VALUESOURCE_DATA &&
+		node->value.data.value.hasValue)
+	{
+		const UA_Variant &range = node->value.data.value.value;
+		// standard Range structure
+		if (range.type == &UA_TYPES[UA_TYPES_RANGE] && UA_Variant_isScalar(&range))
+		{
+			low  = static_cast<const UA_Range*>(range.data)->low;
+			high = static_cast<const UA_Range*>(range.data)->high;
+			ok   = true;
+		}
+		// numeric array [low, high]
+		else if (!UA_Variant_isScalar(&range) && range.arrayLength == 2)
+		{
+			double arr[2];
+			ok   = QUaTypesConverter::uaNumericArrayCopy(
+				range.data, range.type, arr, &UA_TYPES[UA_TYPES_DOUBLE], 2
+			);
+			low  = arr[0];
+			high = arr[1];
+		}
+	}
+	if (node)
+	{
+		UA_NODESTORE_RELEASE(server, reinterpret_cast<const UA_Node*>(node));
+	}
+#if UA_MULTITHREADING >= 100
+	UA_UNLOCK(server->serviceMutex);
+#endif // UA_MULTITHREADING
+	return ok;
+}
+
+void QUaBaseVariable::initWriteDataType(
+	UA_WriteValue   &wv, 
+	const UA_NodeId &dataTypeNodeId) const
+{
+	UA_WriteValue_init(&wv);
+	wv.nodeId         = m_nodeId;
+	wv.attributeId    = UA_ATTRIBUTEID_DATATYPE;
+	wv.value.hasValue = true;
+	auto st = UA_Variant_setScalarCopy(&wv.value.value, &dataTypeNodeId, &UA_TYPES[UA_TYPES_NODEID]);
+	Q_ASSERT(st == UA_STATUSCODE_GOOD);
+	Q_UNUSED(st);
+}
+
+void QUaBaseVariable::initWriteValue(
+	UA_WriteValue       &wv,
+	const UA_Variant    &value,
+	const UA_StatusCode &status,
+	const QDateTime     &sourceTimestamp,
+	const QDateTime     &serverTimestamp) const
+{
 	UA_WriteValue_init(&wv);
 	wv.nodeId         = m_nodeId;
 	wv.attributeId    = UA_ATTRIBUTEID_VALUE;
@@ -721,9 +1528,6 @@ UA_StatusCode QUaBaseVariable::setValueInternal(
 	wv.value.hasSourcePicoseconds = false;
 	wv.value.status               = status;
 	wv.value.hasStatus            = true;
-	auto st = UA_Server_write(m_qUaServer->m_server, &wv);
-	Q_ASSERT(st == UA_STATUSCODE_GOOD);
-	return st;
 }
 
 qint32 QUaBaseVariable::valueRank() const
@@ -734,6 +1538,14 @@ qint32 QUaBaseVariable::valueRank() const
 	{
 		return -1;
 	}
+	if (!m_cacheAttrValid)
+	{
+		this->updateAttributeCache();
+	}
+	if (!m_cacheWriteMask.bits.bValueRank)
+	{
+		return m_cacheValueRank;
+	}
 	// read valueRank
 	qint32 outValueRank;
 	auto st = UA_Server_readValueRank(m_qUaServer->m_server, m_nodeId, &outValueRank);
@@ -748,6 +1560,8 @@ void QUaBaseVariable::setValueRank(const qint32& valueRank){
 	auto st = UA_Server_writeValueRank(m_qUaServer->m_server, m_nodeId, valueRank);
 	Q_ASSERT(st == UA_STATUSCODE_GOOD);
 	Q_UNUSED(st);
+	// update cache
+	m_cacheValueRank = valueRank;
 }
 
 QVector<quint32> QUaBaseVariable::arrayDimensions() const
@@ -758,6 +1572,14 @@ QVector<quint32> QUaBaseVariable::arrayDimensions() const
 	{
 		return QVector<quint32>();
 	}
+	if (!m_cacheAttrValid)
+	{
+		this->updateAttributeCache();
+	}
+	if (!m_cacheWriteMask.bits.bArrrayDimensions)
+	{
+		return m_cacheArrayDimensions;
+	}
 	// read arrayDimensionsSize
 	UA_Variant outArrayDimensions;
 	auto st = UA_Server_readArrayDimensions(m_qUaServer->m_server, m_nodeId, &outArrayDimensions);
@@ -792,6 +1614,14 @@ quint8 QUaBaseVariable::accessLevel() const
 	{
 		return 0;
 	}
+	if (!m_cacheAttrValid)
+	{
+		this->updateAttributeCache();
+	}
+	if (!m_cacheWriteMask.bits.bAccessLevel)
+	{
+		return m_cacheAccessLevel;
+	}
 	// read accessLevel
 	UA_Byte outAccessLevel;
 	auto st = UA_Server_readAccessLevel(m_qUaServer->m_server, m_nodeId, &outAccessLevel);
@@ -808,6 +1638,8 @@ void QUaBaseVariable::setAccessLevel(const quint8 & accessLevel)
 	auto st = UA_Server_writeAccessLevel(m_qUaServer->m_server, m_nodeId, accessLevel);
 	Q_ASSERT(st == UA_STATUSCODE_GOOD);
 	Q_UNUSED(st);
+	// update cache
+	m_cacheAccessLevel = accessLevel;
 }
 
 double QUaBaseVariable::minimumSamplingInterval() const
@@ -818,6 +1650,14 @@ double QUaBaseVariable::minimumSamplingInterval() const
 	{
 		return 0.0;
 	}
+	if (!m_cacheAttrValid)
+	{
+		this->updateAttributeCache();
+	}
+	if (!m_cacheWriteMask.bits.bMinimumSamplingInterval)
+	{
+		return m_cacheMinimumSamplingInterval;
+	}
 	// read minimumSamplingInterval
 	UA_Double outMinimumSamplingInterval;
 	auto st = UA_Server_readMinimumSamplingInterval(m_qUaServer->m_server, m_nodeId, &outMinimumSamplingInterval);
@@ -835,6 +1675,8 @@ void QUaBaseVariable::setMinimumSamplingInterval(const double & minimumSamplingI
 	auto st = UA_Server_writeMinimumSamplingInterval(m_qUaServer->m_server, m_nodeId, minimumSamplingInterval);
 	Q_ASSERT(st == UA_STATUSCODE_GOOD);
 	Q_UNUSED(st);
+	// update cache
+	m_cacheMinimumSamplingInterval = minimumSamplingInterval;
 }
 
 bool QUaBaseVariable::historizing() const
@@ -2,6 +2,8 @@
 #define QUABASEVARIABLE_H
 
 #include <QUaNode>
+#include <QPointer>
+#include <QElapsedTimer>
 
 // traits to detect if T is container and get inner_type
 // NOTE : had to remove template template parameters because is c++17
@@ -22,8 +24,22 @@ struct container_traits<QVector<T>> : std::true_type
 	static const QUaTypesConverter::ArrayType arrType = QUaTypesConverter::ArrayType::QVector;
 };
 
+// traits to detect if T (or inner_type if container) is arithmetic, so can be written directly
+template <typename T, bool = container_traits<T>::value>
+struct typed_value_traits : std::is_arithmetic<T>
+{
+	using inner_type = T;
+};
+
+template <typename T>
+struct typed_value_traits<T, true> : std::is_arithmetic<typename container_traits<T>::inner_type>
+{
+	using inner_type = typename container_traits<T>::inner_type;
+};
+
 class QUaBaseVariable : public QUaNode
 {
+	friend class QUaServer;
 	Q_OBJECT
 	// Variable Attributes
 
@@ -53,6 +69,7 @@ public:
 	explicit QUaBaseVariable(
 		QUaServer* server
 	);
+	~QUaBaseVariable();
 
 	// Attributes API
 
@@ -75,6 +92,8 @@ public:
 		const QMetaType::Type &newDataType     = QMetaType::UnknownType
 	);
 	// Helper, syntactic sugar for QVariant non-supported types
+	// NOTE : arithmetic scalars and QList/QVector of arithmetic types matching the current
+	//        dataType are written directly without QVariant conversion
 	template<typename T>
 	void setValue(
 		const T &value, 
@@ -100,6 +119,40 @@ public:
 			newDataType
 		);
 	};
+	// Contiguous numeric arrays (bool, integers, float and double)
+	// - If T is the current dataType, data is copied with a single memcpy
+	// - If T is another numeric type, data is converted element-wise to the current dataType
+	// - Else behaves like setValue(QVector<T>)
+	template<typename T>
+	void setValueArray(
+		const T               *data, 
+		const int             &size,
+		const QUaStatusCode   &statusCode      = QUaStatus::Good,
+		const QDateTime       &sourceTimestamp = QDateTime(),
+		const QDateTime       &serverTimestamp = QDateTime()
+	);
+	// Copies up to maxSize elements of the current value into buffer without allocating
+	// Returns number of elements copied or -1 if current value is not numeric
+	// NOTE : reads stored value directly, read callback is not called
+	template<typename T>
+	int valueArray(
+		T         *buffer, 
+		const int &maxSize
+	) const;
+	// Binds the value to caller-owned memory of an arithmetic type (scalar or array)
+	// - client reads are encoded directly from the memory, without copies or conversions
+	// - client writes are copied into the memory unless it is const
+	// - memory must remain valid until clearValueSource is called or the variable is deleted
+	// - after modifying the memory call setValueSourceChanged instead of setValue
+	template<typename T>
+	void setValueSource(T *data);
+	template<typename T>
+	void setValueSource(T *data, const int &size);
+	// Unbinds, the current memory contents are copied as the stored value
+	void clearValueSource();
+	bool hasValueSource() const;
+	// Flags bound memory as changed, updates source timestamp (current time if invalid)
+	void setValueSourceChanged(const QDateTime &sourceTimestamp = QDateTime());
 	// Timestamp of the source 
 	virtual QDateTime sourceTimestamp() const;
 	virtual void      setSourceTimestamp(const QDateTime& sourceTimestamp);
@@ -135,6 +188,8 @@ public:
 	void              setMinimumSamplingInterval(const double &minimumSamplingInterval);
 	// Whether the Server is actively collecting data for the history of the Variable
 	bool              historizing() const;
+	// Overwrite to invalidate attribute cache
+	void              setWriteMask(const quint32& writeMask) override;
 #ifdef UA_ENABLE_HISTORIZING
 	void              setHistorizing(const bool & historizing);
 
@@ -144,6 +199,26 @@ public:
 	// set callback which is called before a read is performed
 	// call with the default argument for no pre-read callback
 	void              setReadCallback(const std::function<QVariant()>& readCallback=std::function<QVariant()>());
+	// time in ms the read callback result is served to subsequent reads without calling it again
+	// default 0 calls the read callback on every read
+	qint64            readCallbackMaxAge() const;
+	void              setReadCallbackMaxAge(const qint64& maxAge);
+	// True if at least one client monitored item is sampling the value
+	// NOTE : requires UA_ENABLE_SUBSCRIPTIONS, else always false
+	bool              isMonitored() const;
+	int               monitoredItemsCount() const;
+	// Fastest sampling interval in ms requested by enabled monitored items, -1 if none
+	// NOTE : requires UA_ENABLE_SUBSCRIPTIONS_EVENTS, else always -1
+	double            monitoredSamplingInterval() const;
+	// Deadband applied on setValue, numeric updates within the band are dropped
+	// - Absolute : dropped if |new - old| <= deadbandValue (for arrays, all elements)
+	// - Percent  : dropped if |new - old| <= (deadbandValue/100) * (high - low) of the EURange property
+	//              (EURange can be a Range structure or a numeric array [low, high])
+	// NOTE : updates that change the status code or the array size are never dropped
+	QUaDeadbandType   deadbandType() const;
+	void              setDeadbandType(const QUaDeadbandType& deadbandType);
+	double            deadbandValue() const;
+	void              setDeadbandValue(const double& deadbandValue);
 
 	// Helpers
 
@@ -176,6 +251,7 @@ signals:
 	void sourceTimestampChanged(const QDateTime&     sourceTimestamp, const bool &networkChange);
 	void serverTimestampChanged(const QDateTime&     serverTimestamp, const bool &networkChange);
 	void valueRankChanged      (const quint32&       valueRank      );
+	void monitoredChanged      (const bool&          monitored      );
 
 protected:
 	// cache type for performance
@@ -198,9 +274,64 @@ private:
 		                const UA_NumericRange *range,
 		                const UA_DataValue    *data);
 
+#ifdef UA_ENABLE_SUBSCRIPTIONS
+	static void onMonitoredItemRegister(UA_Server       *server, 
+		                                const UA_NodeId *sessionId, 
+		                                void            *sessionContext,
+		                                const UA_NodeId *nodeId, 
+		                                void            *nodeContext,
+		                                UA_UInt32        attributeId, 
+		                                UA_Boolean       removed);
+#endif // UA_ENABLE_SUBSCRIPTIONS
+
+	static UA_StatusCode onSourceRead (UA_Server             *server, 
+		                               const UA_NodeId       *sessionId,
+		                               void                  *sessionContext, 
+		                               const UA_NodeId       *nodeId,
+		                               void                  *nodeContext, 
+		                               UA_Boolean             includeSourceTimeStamp,
+		                               const UA_NumericRange *range,
+		                               UA_DataValue          *value);
+
+	static UA_StatusCode onSourceWrite(UA_Server             *server, 
+		                               const UA_NodeId       *sessionId,
+		                               void                  *sessionContext, 
+		                               const UA_NodeId       *nodeId,
+		                               void                  *nodeContext, 
+		                               const UA_NumericRange *range,
+		                               const UA_DataValue    *value);
+
 	bool m_bInternalWrite;
 	std::function<QVariant()> m_readCallback;
 	bool m_readCallbackRunning = false;
+	qint64 m_readCallbackMaxAge;
+	int m_monitoredItemsCount;
+	QElapsedTimer m_readCallbackTimer;
+	QUaDeadbandType m_deadbandType;
+	double m_deadbandValue;
+	// index of pending value write, only valid within same batch
+	quint32 m_updateBatch;
+	int     m_updateWrite;
+	QPointer<QUaBaseVariable> m_euRange;
+	// external memory data source, size -1 if scalar
+	void              *m_sourceData;
+	const UA_DataType *m_sourceType;
+	int                m_sourceSize;
+	bool               m_sourceWritable;
+	UA_DateTime        m_sourceTimestamp;
+	// attribute cache, filled on first read and kept coherent on writes
+	// NOTE : status and timestamps are updated in onWrite, other attributes in their setters
+	mutable bool             m_cacheValueValid;
+	mutable QUaStatusCode    m_cacheStatusCode;
+	// NOTE : raw timestamps, only converted to QDateTime by getters
+	mutable UA_DateTime      m_cacheSourceTimestamp;
+	mutable UA_DateTime      m_cacheServerTimestamp;
+	mutable bool             m_cacheAttrValid;
+	mutable QUaWriteMask     m_cacheWriteMask;
+	mutable qint32           m_cacheValueRank;
+	mutable QVector<quint32> m_cacheArrayDimensions;
+	mutable quint8           m_cacheAccessLevel;
+	mutable double           m_cacheMinimumSamplingInterval;
 #ifdef UA_ENABLE_HISTORIZING
 	quint64 m_maxHistoryDataResponseSize;
 #endif // UA_ENABLE_HISTORIZING
@@ -225,6 +356,93 @@ protected:
 		const QDateTime     &sourceTimestamp = QDateTime(),
 		const QDateTime     &serverTimestamp = QDateTime()
 	);
+	// if T not arithmetic
+	template<typename T>
+	void setValueTyped(
+		const T               &value,
+		const QUaStatusCode   &statusCode,
+		const QDateTime       &sourceTimestamp,
+		const QDateTime       &serverTimestamp,
+		const QMetaType::Type &newDataType,
+		std::false_type
+	);
+	// if T arithmetic (or container of)
+	template<typename T>
+	void setValueTyped(
+		const T               &value,
+		const QUaStatusCode   &statusCode,
+		const QDateTime       &sourceTimestamp,
+		const QDateTime       &serverTimestamp,
+		const QMetaType::Type &newDataType,
+		std::true_type
+	);
+	// write already converted value of same dataType, takes ownership of value
+	virtual void setValueDirect(
+		UA_Variant          &value,
+		const UA_StatusCode &status,
+		const QDateTime     &sourceTimestamp,
+		const QDateTime     &serverTimestamp
+	);
+	// contiguous numeric arrays, return false if current dataType is not numeric
+	bool setValueArrayInternal(
+		const void          *data,
+		const int           &size,
+		const UA_DataType   *type,
+		const UA_StatusCode &status,
+		const QDateTime     &sourceTimestamp,
+		const QDateTime     &serverTimestamp
+	);
+	int valueArrayInternal(
+		void              *buffer,
+		const int         &maxSize,
+		const UA_DataType *type
+	) const;
+	// bind external memory data source
+	void setValueSourceInternal(
+		void              *data,
+		const UA_DataType *type,
+		const int         &size,
+		const bool        &writable
+	);
+	// fill attribute cache
+	void updateValueCache() const;
+	void updateAttributeCache() const;
+	// true if new value is within deadband of stored (or pending batch) value
+	bool isInDeadband(
+		const UA_Variant    &value,
+		const UA_StatusCode &status
+	);
+	static bool isInDeadband(
+		const UA_DataValue  &oldValue,
+		const UA_Variant    &value,
+		const UA_StatusCode &status,
+		const double        &band
+	);
+	// EURange property, false if not available
+	bool euRange(
+		double &low, 
+		double &high
+	);
+	// batch update, add value and data type writes to server (takes ownership of value)
+	void addUpdateWrites(
+		UA_Variant            &value,
+		const UA_StatusCode   &status,
+		const QDateTime       &sourceTimestamp,
+		const QDateTime       &serverTimestamp,
+		const QMetaType::Type &newDataType
+	);
+	// fill write structures (shallow copy of node id and value)
+	void initWriteDataType(
+		UA_WriteValue   &wv,
+		const UA_NodeId &dataTypeNodeId
+	) const;
+	void initWriteValue(
+		UA_WriteValue       &wv,
+		const UA_Variant    &value,
+		const UA_StatusCode &status,
+		const QDateTime     &sourceTimestamp,
+		const QDateTime     &serverTimestamp
+	) const;
 };
 // generic version scalar or array
 template<typename T>
@@ -252,6 +470,25 @@ inline void QUaBaseVariable::setValue(
 	const QDateTime& sourceTimestamp,
 	const QDateTime& serverTimestamp,
 	const QMetaType::Type& newDataType)
+{
+	this->setValueTyped<T>(
+		value,
+		statusCode,
+		sourceTimestamp,
+		serverTimestamp,
+		newDataType,
+		typed_value_traits<T>()
+	);
+}
+// if not arithmetic
+template<typename T>
+inline void QUaBaseVariable::setValueTyped(
+	const T& value,
+	const QUaStatusCode& statusCode,
+	const QDateTime& sourceTimestamp,
+	const QDateTime& serverTimestamp,
+	const QMetaType::Type& newDataType,
+	std::false_type)
 {
 	this->setValue(
 		QVariant::fromValue(value),
@@ -261,5 +498,112 @@ inline void QUaBaseVariable::setValue(
 		newDataType
 	);
 }
+// if arithmetic
+template<typename T>
+inline void QUaBaseVariable::setValueTyped(
+	const T& value,
+	const QUaStatusCode& statusCode,
+	const QDateTime& sourceTimestamp,
+	const QDateTime& serverTimestamp,
+	const QMetaType::Type& newDataType,
+	std::true_type)
+{
+	using inner_type = typename typed_value_traits<T>::inner_type;
+	// type conversion needed, use generic version
+	// NOTE : compare memory layout, metatype of T can differ for same ua type (qint64 vs Long)
+	if (newDataType != QMetaType::UnknownType ||
+		QUaTypesConverter::uaTypeFromCpp<inner_type>() != QUaTypesConverter::uaTypeFromQType(m_dataType))
+	{
+		this->setValue(
+			QVariant::fromValue(value),
+			statusCode,
+			sourceTimestamp,
+			serverTimestamp,
+			newDataType
+		);
+		return;
+	}
+	// same type, no need to box into QVariant and infer type
+	auto uaVar = QUaTypesConverter::uaVariantFromCpp(value);
+	this->setValueDirect(
+		uaVar,
+		statusCode,
+		sourceTimestamp,
+		serverTimestamp
+	);
+}
+
+template<typename T>
+inline void QUaBaseVariable::setValueSource(T* data)
+{
+	typedef typename std::remove_const<T>::type value_type;
+	static_assert(std::is_arithmetic<value_type>::value, "QUaBaseVariable::setValueSource only supports arithmetic types.");
+	this->setValueSourceInternal(
+		const_cast<value_type*>(data),
+		QUaTypesConverter::uaTypeFromCpp<value_type>(),
+		-1,
+		!std::is_const<T>::value
+	);
+}
+
+template<typename T>
+inline void QUaBaseVariable::setValueSource(T* data, const int& size)
+{
+	typedef typename std::remove_const<T>::type value_type;
+	static_assert(std::is_arithmetic<value_type>::value, "QUaBaseVariable::setValueSource only supports arithmetic types.");
+	Q_ASSERT(size >= 0);
+	this->setValueSourceInternal(
+		const_cast<value_type*>(data),
+		QUaTypesConverter::uaTypeFromCpp<value_type>(),
+		size,
+		!std::is_const<T>::value
+	);
+}
+
+template<typename T>
+inline void QUaBaseVariable::setValueArray(
+	const T* data, 
+	const int& size, 
+	const QUaStatusCode& statusCode, 
+	const QDateTime& sourceTimestamp, 
+	const QDateTime& serverTimestamp)
+{
+	static_assert(std::is_arithmetic<T>::value, "QUaBaseVariable::setValueArray only supports arithmetic types.");
+	Q_ASSERT(data || size == 0);
+	if (this->setValueArrayInternal(
+		data,
+		size,
+		QUaTypesConverter::uaTypeFromCpp<T>(),
+		statusCode,
+		sourceTimestamp,
+		serverTimestamp
+	))
+	{
+		return;
+	}
+	// current dataType not numeric, use generic version
+	QVector<T> vect(size);
+	std::copy(data, data + size, vect.begin());
+	this->setValue(
+		QVariant::fromValue(vect),
+		statusCode,
+		sourceTimestamp,
+		serverTimestamp
+	);
+}
+
+template<typename T>
+inline int QUaBaseVariable::valueArray(
+	T* buffer, 
+	const int& maxSize) const
+{
+	static_assert(std::is_arithmetic<T>::value, "QUaBaseVariable::valueArray only supports arithmetic types.");
+	Q_ASSERT(buffer || maxSize == 0);
+	return this->valueArrayInternal(
+		buffer,
+		maxSize,
+		QUaTypesConverter::uaTypeFromCpp<T>()
+	);
+}
 
 #endif // QUABASEVARIABLE_H
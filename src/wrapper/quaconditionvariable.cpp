@@ -2,6 +2,7 @@
 
 #ifdef UA_ENABLE_SUBSCRIPTIONS_ALARMS_CONDITIONS
 
+#include <QUaServer>
 #include <QUaProperty>
 
 QUaConditionVariable::QUaConditionVariable(
@@ -24,12 +25,40 @@ void QUaConditionVariable::setValue(
 	const QDateTime& serverTimestamp, 
 	const QMetaType::Type& newType)
 {
+	// batch update, value is not written until commit so sync child with timestamp to be written
+	if (m_qUaServer->isUpdating())
+	{
+		QDateTime timestamp = sourceTimestamp.isValid() ? sourceTimestamp : QDateTime::currentDateTimeUtc();
+		QUaBaseVariable::setValue(value, statusCode, timestamp, serverTimestamp, newType);
+		this->getSourceTimestamp()->setValue(timestamp.toUTC());
+		return;
+	}
 	// call base implementation
 	QUaBaseVariable::setValue(value, statusCode, sourceTimestamp, serverTimestamp, newType);
 	// update child property
 	this->getSourceTimestamp()->setValue(QUaBaseVariable::sourceTimestamp());
 }
 
+void QUaConditionVariable::setValueDirect(
+	UA_Variant& value, 
+	const UA_StatusCode& status, 
+	const QDateTime& sourceTimestamp, 
+	const QDateTime& serverTimestamp)
+{
+	// batch update, same as above
+	if (m_qUaServer->isUpdating())
+	{
+		QDateTime timestamp = sourceTimestamp.isValid() ? sourceTimestamp : QDateTime::currentDateTimeUtc();
+		QUaBaseVariable::setValueDirect(value, status, timestamp, serverTimestamp);
+		this->getSourceTimestamp()->setValue(timestamp.toUTC());
+		return;
+	}
+	// call base implementation
+	QUaBaseVariable::setValueDirect(value, status, sourceTimestamp, serverTimestamp);
+	// update child property
+	this->getSourceTimestamp()->setValue(QUaBaseVariable::sourceTimestamp());
+}
+
 void QUaConditionVariable::setSourceTimestamp(const QDateTime& sourceTimestamp)
 {
 	// call base implementation
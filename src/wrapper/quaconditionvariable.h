@@ -34,6 +34,15 @@ public:
 	// Overwrite to sync this variable's source timestamp with the child property
 	void setSourceTimestamp(const QDateTime& sourceTimestamp) override;
 
+protected:
+	// Overwrite to sync the child property also on typed setValue
+	void setValueDirect(
+		UA_Variant          &value,
+		const UA_StatusCode &status,
+		const QDateTime     &sourceTimestamp,
+		const QDateTime     &serverTimestamp
+	) override;
+
 private slots:
 	void on_setSourceTimestampChanged(const QDateTime& sourceTimestamp);
 
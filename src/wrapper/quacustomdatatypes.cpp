@@ -331,12 +331,14 @@ QUaQualifiedName::QUaQualifiedName()
 {
 	m_namespace = 0;
 	m_name = QString();
+	this->updateHash();
 }
 
 QUaQualifiedName::QUaQualifiedName(const quint16& namespaceIndex, const QString& name)
 {
 	m_namespace = namespaceIndex;
 	m_name = name;
+	this->updateHash();
 }
 
 QUaQualifiedName::QUaQualifiedName(const UA_QualifiedName& uaQualName)
@@ -374,6 +376,7 @@ void QUaQualifiedName::operator=(const UA_QualifiedName& uaQualName)
 {
 	m_namespace = uaQualName.namespaceIndex;
 	m_name = QUaTypesConverter::uaStringToQString(uaQualName.name);
+	this->updateHash();
 }
 
 void QUaQualifiedName::operator=(const QString& strXmlQualName)
@@ -385,6 +388,7 @@ void QUaQualifiedName::operator=(const QString& strXmlQualName)
 	{
 		// if no valid xml format, assume ns = 0 and given string is name
 		m_name = strXmlQualName;
+		this->updateHash();
 		return;
 	}
 	// check if valid namespace found, else assume ns = 0 and given string is name
@@ -397,6 +401,7 @@ void QUaQualifiedName::operator=(const QString& strXmlQualName)
 		if (!success || ns > (std::numeric_limits<quint16>::max)())
 		{
 			m_name = strXmlQualName;
+			this->updateHash();
 			return;
 		}
 		new_ns = ns;
@@ -409,6 +414,7 @@ void QUaQualifiedName::operator=(const QString& strXmlQualName)
 		!strLast.contains(QLatin1String("b=")))
 	{
 		m_name = strXmlQualName;
+		this->updateHash();
 		return;
 	}
 	auto lastParts = strLast.split(QLatin1String("="));
@@ -420,6 +426,7 @@ void QUaQualifiedName::operator=(const QString& strXmlQualName)
 		lastParts.size() == 2 ?
 		lastParts.last().toString() :
 		lastParts.at(1).toString();
+	this->updateHash();
 }
 
 void QUaQualifiedName::operator=(const char* strXmlQualName)
@@ -430,14 +437,18 @@ void QUaQualifiedName::operator=(const char* strXmlQualName)
 
 bool QUaQualifiedName::operator==(const QUaQualifiedName& other) const
 {
-	return m_namespace == other.m_namespace &&
+	if (m_namespace != other.m_namespace || m_hash != other.m_hash)
+	{
+		return false;
+	}
+	// names interned by the server share data
+	return m_name.constData() == other.m_name.constData() ||
 		m_name.compare(other.m_name, Qt::CaseSensitive) == 0;
 }
 
 bool QUaQualifiedName::operator!=(const QUaQualifiedName& other) const
 {
-	return m_namespace != other.m_namespace ||
-		m_name.compare(other.m_name, Qt::CaseSensitive) != 0;
+	return !(*this == other);
 }
 
 bool QUaQualifiedName::operator<(const QUaQualifiedName& other) const
@@ -457,6 +468,7 @@ quint16 QUaQualifiedName::namespaceIndex() const
 void QUaQualifiedName::setNamespaceIndex(const quint16& index)
 {
 	m_namespace = index;
+	this->updateHash();
 }
 
 QString QUaQualifiedName::name() const
@@ -467,6 +479,7 @@ QString QUaQualifiedName::name() const
 void QUaQualifiedName::setName(const QString& name)
 {
 	m_name = name;
+	this->updateHash();
 }
 
 QString QUaQualifiedName::toXmlString() const
@@ -486,6 +499,11 @@ bool QUaQualifiedName::isEmpty() const
 	return m_name.isEmpty();
 }
 
+void QUaQualifiedName::updateHash()
+{
+	m_hash = qHash(m_name, m_namespace);
+}
+
 QUaQualifiedName QUaQualifiedName::fromXmlString(const QString& strXmlQualName)
 {
 	return QUaQualifiedName(strXmlQualName);
@@ -129,6 +129,14 @@ namespace QUa
 		DataTypeChanged  = 16
 	};
 	Q_ENUM_NS(ChangeVerb)
+
+	enum class DeadbandType
+	{
+		None     = 0,
+		Absolute = 1,
+		Percent  = 2
+	};
+	Q_ENUM_NS(DeadbandType)
 }
 typedef QUa::LogLevel    QUaLogLevel;
 typedef QUa::LogCategory QUaLogCategory;
@@ -136,6 +144,8 @@ typedef QUa::Status      QUaStatus;
 
 typedef QUa::ChangeVerb  QUaChangeVerb;
 
+typedef QUa::DeadbandType QUaDeadbandType;
+
 struct QUaLog
 {
 	// default constructor required by Qt
@@ -569,22 +579,29 @@ public:
 
 private:
 	quint16 m_namespace;
+	// precomputed, updated when name or namespace change
+	// NOTE : declared next to namespace so both fit before name without padding
+	uint    m_hash;
+	// NOTE : browse names stored in nodes are interned by the server (share string data)
 	QString m_name;
+	void updateHash();
 
 	friend QDataStream& operator<<(QDataStream& outStream, const QUaQualifiedName& inQualName);
 	friend QDataStream& operator>>(QDataStream& inStream, QUaQualifiedName& outQualName);
+	friend uint qHash(const QUaQualifiedName& key);
+	friend uint qHash(const QUaQualifiedName& key, uint seed);
 };
 
 Q_DECLARE_METATYPE(QUaQualifiedName);
 
 inline uint qHash(const QUaQualifiedName& key)
 {
-	return qHash(key.name(), key.namespaceIndex());
+	return key.m_hash;
 }
 
 inline uint qHash(const QUaQualifiedName& key, uint seed)
 {
-	return qHash(key.name(), seed) ^ key.namespaceIndex();
+	return key.m_hash ^ seed;
 }
 
 inline QDataStream& operator<<(QDataStream& outStream, const QUaQualifiedName& inQualName)
@@ -598,6 +615,7 @@ inline QDataStream& operator>>(QDataStream& inStream, QUaQualifiedName& outQualN
 {
 	inStream >> outQualName.m_namespace;
 	inStream >> outQualName.m_name;
+	outQualName.updateHash();
 	return inStream;
 }
 
@@ -654,6 +672,11 @@ inline bool operator==(const QUaChangeStructureDataType& lhs, const QUaChangeStr
 		   lhs.m_uiVerb == rhs.m_uiVerb;
 }
 
+inline uint qHash(const QUaChangeStructureDataType& key, uint seed = 0)
+{
+	return qHash(key.m_nodeIdAffected, seed) ^ qHash(key.m_uiVerb, seed);
+}
+
 Q_DECLARE_METATYPE(QUaChangeStructureDataType);
 
 // NOTE : automatic
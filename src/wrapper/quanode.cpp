@@ -4,6 +4,7 @@
 #include <QUaProperty>
 #include <QUaBaseDataVariable>
 #include <QUaFolderObject>
+#include <QVarLengthArray>
 
 #ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
 #include <QUaBaseEvent>
@@ -126,106 +127,87 @@ QUaNode::QUaNode(
 	UA_Server_setNodeContext(server->m_server, nodeId, (void*)this);
 	// set node id to c++ instance
 	this->m_nodeId = nodeId;
+	server->m_hashNodes[nodeId] = this;
+	this->m_indexParent = nullptr;
+	this->m_childrenLazy = false;
+	this->m_subtreeDeleted = false;
+	this->m_nodeBrowsePathInBranch = false;
+	// add to instances of its type
+	this->m_typeMetaObject = nullptr;
+	this->m_typePrev = nullptr;
+	this->m_typeNext = nullptr;
+	server->addTypeInstance(this, &metaObject);
 	// ignore objects folder
 	UA_NodeId objectsFolderNodeId = UA_NODEID_NUMERIC(0, UA_NS0ID_OBJECTSFOLDER);
 	if (UA_NodeId_equal(&nodeId, &objectsFolderNodeId))
 	{ 
 		return; 
 	}
-	// get all UA children in advance, because if none, then better early exit
-	auto chidrenNodeIds = QUaNode::getChildrenNodeIds(nodeId, server->m_server);
-	if (chidrenNodeIds.count() <= 0)
-	{ 
-		return; 
-	}
-	// create hash of nodeId's by browse name, which must match Qt's metaprops
-	QHash<QUaQualifiedName, UA_NodeId> mapChildren;
-	for (auto &childNodeId : chidrenNodeIds)
-	{
-		// read browse name
-		QUaQualifiedName browseName = QUaNode::getBrowseName(childNodeId, server->m_server);
-		Q_ASSERT(!mapChildren.contains( browseName));
-		mapChildren[browseName] = childNodeId;
-	}
-	// list meta props
-	int propCount  = metaObject.propertyCount();
-	int propOffset = QUaNode::getPropsOffsetHelper(metaObject);
-	int numProps   = 0;
-	for (int i = propOffset; i < propCount; i++)
-	{
-		QMetaProperty metaProperty = metaObject.property(i);
-		// check if not enum
-		if (!metaProperty.isEnumType())
+	// bind children using the type layout (browse names computed once per type)
+	// NOTE : copy, instantiating children of children can add layouts to the cache
+	const QVector<QUaQualifiedName> layout = server->typeLayout(metaObject, nodeId);
+	for (const auto &browseName : layout)
+	{
+		// resolve child by browse name, no need to browse and read all children
+		UA_QualifiedName uaBrowseName = browseName;
+		UA_BrowsePathResult bRes = UA_Server_browseSimplifiedBrowsePath(
+			server->m_server, nodeId, 1, &uaBrowseName);
+		UA_QualifiedName_clear(&uaBrowseName);
+		// if assert below fails, review QUaServer::typeLayout
+		Q_ASSERT_X(bRes.statusCode == UA_STATUSCODE_GOOD && bRes.targetsSize == 1, 
+			"QUaNode::QUaNode", "Children not bound properly.");
+		// get node context (C++ instance)
+		auto nodeInstance = bRes.targetsSize > 0 ?
+			QUaNode::getNodeContext(bRes.targets[0].targetId.nodeId, server->m_server) :
+			nullptr;
+		UA_BrowsePathResult_clear(&bRes);
+		// lazy instantiation, leave it for later
+		if (!nodeInstance && server->m_lazyInstantiation)
 		{
-			// check if available in meta-system
-			if (!QMetaType::metaObjectForType(metaProperty.userType()))
-			{ continue; }
-			// check if OPC UA relevant type
-			const QMetaObject propMetaObject = *QMetaType::metaObjectForType(metaProperty.userType());
-			if (!propMetaObject.inherits(&QUaNode::staticMetaObject))
-			{ continue; }
-			// check if prop inherits from parent
-			Q_ASSERT_X(!propMetaObject.inherits(&metaObject), "QUaNode Constructor", 
-				"Qt MetaProperty type cannot inherit from Class.");
-			if (propMetaObject.inherits(&metaObject))
-			{ continue; }
+			m_childrenLazy = true;
+			continue;
 		}
-		// inc number of valid props
-		numProps++;
-		// the Qt meta property name must match the UA browse name
-		QUaQualifiedName browseName = QString(metaProperty.name());
-		Q_ASSERT(mapChildren.contains(browseName));
-		// get child nodeId for child
-		auto childNodeId = mapChildren.take(browseName);
-		// get node context (C++ instance)
-		auto nodeInstance = QUaNode::getNodeContext(childNodeId, server->m_server);
 		Q_CHECK_PTR(nodeInstance);
+		if (!nodeInstance)
+		{
+			continue;
+		}
 		// assign C++ parent
 		nodeInstance->setParent(this);
 		nodeInstance->setObjectName(browseName);
 		Q_ASSERT(!this->browseChild(browseName));
-		uint key = qHash(browseName);
-		m_browseCache[key] = nodeInstance;
-		QObject::connect(nodeInstance, &QObject::destroyed, this, [this, key]() {
-			m_browseCache.remove(key);
-		});
+		this->addChildToIndex(nodeInstance, browseName);
 		// [NOTE] writing a pointer value to a Q_PROPERTY did not work, 
 		//        eventhough there appear to be some success cases on the internet
 		//        so in the end we have to query children by object name
-	} // for each prop
-	// handle mandatory children of instance declarations
-	QUaNodeId typeNodeId = this->typeDefinitionNodeId();
-	Q_ASSERT(m_qUaServer->m_hashMandatoryChildren.contains(typeNodeId));
-	const auto &mandatoryList = m_qUaServer->m_hashMandatoryChildren[typeNodeId];
-	for (const auto browseName : mandatoryList)
-	{
-		Q_ASSERT(mapChildren.contains(browseName));
-		// get child nodeId for child
-		auto childNodeId = mapChildren.take(browseName);
-		// get node context (C++ instance)
-		auto nodeInstance = QUaNode::getNodeContext(childNodeId, server->m_server);
-		Q_CHECK_PTR(nodeInstance);
-		// assign C++ parent
-		nodeInstance->setParent(this);
-		nodeInstance->setObjectName(browseName);
-		Q_ASSERT(!this->browseChild(browseName));
-		uint key = qHash(browseName);
-		m_browseCache[key] = nodeInstance;
-		QObject::connect(nodeInstance, &QObject::destroyed, this, [this, key]() {
-			m_browseCache.remove(key);
-		});
-	}
-	// if assert below fails, review filter in QUaNode::getChildrenNodeIds
-	Q_ASSERT_X(mapChildren.count() == 0, "QUaNode::QUaNode", "Children not bound properly.");
-	// cleanup
-	for (auto childNodeId : chidrenNodeIds)
-	{
-		UA_NodeId_clear(&childNodeId);
 	}
 }
 
 QUaNode::~QUaNode()
 {
+	// detach children index (children are deleted by QObject after this destructor)
+	for (auto child : m_children)
+	{
+		child->m_indexParent = nullptr;
+	}
+	m_children.clear();
+	m_childrenByName.clear();
+	if (m_indexParent)
+	{
+		m_indexParent->removeChildFromIndex(this);
+	}
+	// remove from index of bound nodes
+	auto iter = m_qUaServer->m_hashNodes.find(m_nodeId);
+	if (iter != m_qUaServer->m_hashNodes.end() && iter.value() == this)
+	{
+		m_qUaServer->m_hashNodes.erase(iter);
+	}
+	m_qUaServer->removeTypeInstance(this);
+	// already removed from node store by deleteSubtree
+	if (m_subtreeDeleted)
+	{
+		return;
+	}
 	// check if node id has been already removed from node store
 	// i.e. child of deleted parent node, or ...
 	UA_NodeId outNodeId;
@@ -262,6 +244,64 @@ QUaNode::~QUaNode()
 #endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
 }
 
+static UA_StatusCode clearNodeContext(
+	UA_Server  *server,
+	UA_Session *session,
+	UA_Node    *node,
+	void       *data)
+{
+	Q_UNUSED(server);
+	Q_UNUSED(session);
+	Q_UNUSED(data);
+	node->context = nullptr;
+	return UA_STATUSCODE_GOOD;
+}
+
+void QUaNode::deleteSubtree()
+{
+	// collect subtree once (breadth first)
+	QVector<QUaNode*> subtree;
+	subtree << this;
+	for (int i = 0; i < subtree.count(); i++)
+	{
+		subtree += subtree.at(i)->m_children;
+	}
+	// remove contexts, so we avoid double deleting in ua destructor when called
+	// and mark nodes so their destructors skip the node store
+	// NOTE : edit nodes directly under a single lock instead of one public api call per node
+	auto server = m_qUaServer->m_server;
+#if UA_MULTITHREADING >= 100
+	UA_LOCK(server->serviceMutex);
+#endif // UA_MULTITHREADING
+	for (auto node : subtree)
+	{
+		node->m_subtreeDeleted = true;
+		UA_Server_editNode(server, &server->adminSession, &node->m_nodeId, &clearNodeContext, nullptr);
+	}
+#if UA_MULTITHREADING >= 100
+	UA_UNLOCK(server->serviceMutex);
+#endif // UA_MULTITHREADING
+	// delete in ua, children are deleted recursively (NOTE : also delete references)
+	auto st = UA_Server_deleteNode(server, m_nodeId, true);
+	Q_ASSERT(st == UA_STATUSCODE_GOOD || st == UA_STATUSCODE_BADNODEIDUNKNOWN);
+	Q_UNUSED(st);
+	// trigger a single reference deleted, model change event
+#ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
+	Q_CHECK_PTR(m_qUaServer->m_changeEvent);
+	QUaNode* parent = qobject_cast<QUaNode*>(this->parent());
+	if (parent && parent->inAddressSpace())
+	{
+		m_qUaServer->addChange({
+			parent->nodeId(),
+			parent->typeDefinitionNodeId(),
+			QUaChangeVerb::ReferenceDeleted
+		});
+	}
+#endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
+	// delete c++ instances, QObject deletes children
+	delete this;
+}
+
 bool QUaNode::operator==(const QUaNode & other) const
 {
 	return UA_NodeId_equal(&this->m_nodeId, &other.m_nodeId);
@@ -392,7 +432,7 @@ QUaQualifiedName QUaNode::browseName() const
 	Q_ASSERT(st == UA_STATUSCODE_GOOD);
 	Q_UNUSED(st);
 	// update cache
-	const_cast<QUaNode*>(this)->m_browseName = outBrowseName;
+	const_cast<QUaNode*>(this)->m_browseName = m_qUaServer->internBrowseName(outBrowseName);
 	// cleanup
 	UA_QualifiedName_clear(&outBrowseName);
 	return m_browseName;
@@ -565,29 +605,45 @@ QUaQualifiedName QUaNode::typeDefinitionBrowseName() const
 
 QList<QUaNode*> QUaNode::browseChildren() const
 {
-	// TODO : check if faster with open62541 browse API
-	return this->findChildren<QUaNode*>(QString(), Qt::FindDirectChildrenOnly);
+	if (m_childrenLazy)
+	{
+		const_cast<QUaNode*>(this)->materializeChildren();
+	}
+	return m_children.toList();
 }
 
+// below this number of children a linear scan is cheaper than a hash
+static const int QUA_CHILDREN_HASH_MIN = 16;
+
 QUaNode* QUaNode::browseChild(
 	const QUaQualifiedName&  browseName,
 	const bool& instantiateOptional/* = false*/)
 {
-	// first check cache
+	// first check index
 	QUaNode* child = nullptr;
-	uint key = qHash(browseName);
-	if (m_browseCache.contains(key))
+	if (!m_childrenByName.isEmpty())
 	{
-		child = m_browseCache.value(key);
-		if (child || !instantiateOptional)
+		child = m_childrenByName.value(browseName, nullptr);
+	}
+	else
+	{
+		for (auto node : m_children)
 		{
-			return child;
+			if (node->m_browseName == browseName)
+			{
+				child = node;
+				break;
+			}
 		}
 	}
-	if (!instantiateOptional)
+	// lazy instantiation
+	if (!child && m_childrenLazy)
 	{
-		m_browseCache[key] = nullptr;
-		return nullptr;
+		child = this->materializeChild(browseName);
+	}
+	if (child || !instantiateOptional)
+	{
+		return child;
 	}
 	child = this->instantiateOptionalChild(browseName);
 	Q_ASSERT_X(child, "QUaNode::browseChild", "TODO : error log");
@@ -596,11 +652,127 @@ QUaNode* QUaNode::browseChild(
 
 bool QUaNode::hasChild(const QUaQualifiedName &browseName)
 {
-	// NOTE : do not use m_browseCache.contains because maybe we tested if existed
-	//        and cached a nullptr. This will giv a false positive
 	return this->browseChild(browseName);
 }
 
+void QUaNode::addChildToIndex(QUaNode* child, const QUaQualifiedName& browseName)
+{
+	Q_CHECK_PTR(child);
+	Q_ASSERT(!child->m_indexParent);
+	// cache browse name, it is immutable
+	child->m_browseName  = m_qUaServer->internBrowseName(browseName);
+	child->m_indexParent = this;
+	child->invalidateNodeBrowsePath();
+	m_children << child;
+	if (!m_childrenByName.isEmpty())
+	{
+		m_childrenByName.insert(child->m_browseName, child);
+		return;
+	}
+	if (m_children.count() < QUA_CHILDREN_HASH_MIN)
+	{
+		return;
+	}
+	// build hash once threshold reached
+	m_childrenByName.reserve(m_children.count() * 2);
+	for (auto node : m_children)
+	{
+		m_childrenByName.insert(node->m_browseName, node);
+	}
+}
+
+QUaNode* QUaNode::materializeChild(const UA_NodeId& childNodeId, const QUaQualifiedName& browseName)
+{
+	if (!m_childrenLazy)
+	{
+		return nullptr;
+	}
+	auto server = m_qUaServer->m_server;
+	// could have been bound already (not yet ours if being added)
+	QUaNode* newInstance = QUaNode::getNodeContext(childNodeId, server);
+	if (newInstance)
+	{
+		return newInstance->m_indexParent == this ? newInstance : nullptr;
+	}
+	// lite variables are only instantiated through QUaServer::materializeLiteVariable
+	if (m_qUaServer->m_liteHandles.contains(childNodeId))
+	{
+		return nullptr;
+	}
+	// only registered types can be instantiated
+	UA_NodeId typeNodeId = QUaNode::typeDefinitionNodeId(childNodeId, server);
+	const QMetaObject* metaObject = m_qUaServer->metaObjectByTypeId(typeNodeId);
+	UA_NodeId_clear(&typeNodeId);
+	if (!metaObject)
+	{
+		return nullptr;
+	}
+	// NOTE : node id ownership is transferred to the new instance
+	UA_NodeId nodeId;
+	UA_NodeId_copy(&childNodeId, &nodeId);
+	newInstance = m_qUaServer->instantiateNode(&nodeId, *metaObject);
+	if (!newInstance)
+	{
+		UA_NodeId_clear(&nodeId);
+		return nullptr;
+	}
+	// need to set parent and browse name
+	newInstance->setParent(this);
+	newInstance->setObjectName(browseName);
+	this->addChildToIndex(newInstance, browseName);
+	return newInstance;
+}
+
+QUaNode* QUaNode::materializeChild(const QUaQualifiedName& browseName)
+{
+	// find child in nodestore
+	UA_QualifiedName uaBrowseName = browseName;
+	UA_BrowsePathResult bRes = UA_Server_browseSimplifiedBrowsePath(
+		m_qUaServer->m_server, m_nodeId, 1, &uaBrowseName);
+	QUaNode* child = nullptr;
+	if (bRes.statusCode == UA_STATUSCODE_GOOD && bRes.targetsSize > 0)
+	{
+		child = this->materializeChild(bRes.targets[0].targetId.nodeId, browseName);
+	}
+	UA_BrowsePathResult_clear(&bRes);
+	UA_QualifiedName_clear(&uaBrowseName);
+	return child;
+}
+
+void QUaNode::materializeChildren()
+{
+	auto server = m_qUaServer->m_server;
+	auto chidrenNodeIds = QUaNode::getChildrenNodeIds(m_nodeId, server);
+	for (auto& childNodeId : chidrenNodeIds)
+	{
+		if (!QUaNode::getVoidContext(childNodeId, server))
+		{
+			this->materializeChild(childNodeId, QUaNode::getBrowseName(childNodeId, server));
+		}
+		UA_NodeId_clear(&childNodeId);
+	}
+	m_childrenLazy = false;
+}
+
+void QUaNode::removeChildFromIndex(QUaNode* child)
+{
+	Q_CHECK_PTR(child);
+	Q_ASSERT(child->m_indexParent == this);
+	child->m_indexParent = nullptr;
+	child->invalidateNodeBrowsePath();
+	// search from back, recently added children are more likely to be removed
+	int index = m_children.lastIndexOf(child);
+	Q_ASSERT(index >= 0);
+	if (index >= 0)
+	{
+		m_children.remove(index);
+	}
+	if (!m_childrenByName.isEmpty())
+	{
+		m_childrenByName.remove(child->m_browseName);
+	}
+}
+
 QUaNode * QUaNode::browsePath(const QUaBrowsePath& browsePath) const
 {
 	QUaNode * currNode = const_cast<QUaNode *>(this);
@@ -617,28 +789,73 @@ QUaNode * QUaNode::browsePath(const QUaBrowsePath& browsePath) const
 
 QUaBrowsePath QUaNode::nodeBrowsePath() const
 {
-	// get parents browse path and then attach current browse name
-	// stop recursion if current node is ObjectsFolder
-	if (this == m_qUaServer->objectsFolder())
+	// check cache, implicitly shared so no allocation
+	if (!m_nodeBrowsePath.isEmpty())
 	{
-		return QUaBrowsePath() << this->browseName();
+		return m_nodeBrowsePath;
 	}
-#ifdef QT_DEBUG 
-	QUaNode* parent = qobject_cast<QUaNode*>(this->parent());
-	// handle hidden nodes (i.e. branches)
+	// walk up parents until ObjectsFolder, no intermediate paths are built
+	const QUaNode* objectsFolder = m_qUaServer->objectsFolder();
+	QVarLengthArray<const QUaNode*, 16> branch;
+	bool indexed = true;
+	const QUaNode* node = this;
+	while (node != objectsFolder)
+	{
+		branch.append(node);
+		QUaNode* parent = node->m_indexParent;
+		if (parent)
+		{
+			node = parent;
+			continue;
+		}
+		// not in children index, so cache could not be invalidated
+		indexed = false;
+		parent = qobject_cast<QUaNode*>(node->parent());
+		// handle hidden nodes (i.e. branches)
 #ifndef UA_ENABLE_SUBSCRIPTIONS_ALARMS_CONDITIONS
-	Q_ASSERT(parent);
+		Q_ASSERT(parent);
 #else
-	Q_ASSERT(parent || qobject_cast<const QUaCondition*>(this));
+		Q_ASSERT(parent || qobject_cast<const QUaCondition*>(node));
 #endif // !UA_ENABLE_SUBSCRIPTIONS_ALARMS_CONDITIONS
-	if (!parent)
+		if (!parent)
+		{
+			break;
+		}
+		node = parent;
+	}
+	QUaBrowsePath browsePath;
+	browsePath.reserve(branch.count() + 1);
+	browsePath << objectsFolder->browseName();
+	for (int i = branch.count() - 1; i >= 0; i--)
 	{
-		return QUaBrowsePath() << m_qUaServer->objectsFolder()->browseName() << this->browseName();
+		browsePath << branch.at(i)->browseName();
+	}
+	if (!indexed)
+	{
+		return browsePath;
+	}
+	// mark branch so invalidation only visits cached descendants
+	for (auto branchNode : branch)
+	{
+		branchNode->m_nodeBrowsePathInBranch = true;
+	}
+	m_nodeBrowsePath = browsePath;
+	return m_nodeBrowsePath;
+}
+
+void QUaNode::invalidateNodeBrowsePath()
+{
+	// NOTE : descendants can be cached even if this node is not
+	if (!m_nodeBrowsePathInBranch)
+	{
+		return;
+	}
+	m_nodeBrowsePathInBranch = false;
+	m_nodeBrowsePath.clear();
+	for (auto child : m_children)
+	{
+		child->invalidateNodeBrowsePath();
 	}
-#else
-	QUaNode* parent = static_cast<QUaNode*>(this->parent());
-#endif // QT_DEBUG 
-	return parent->nodeBrowsePath() << this->browseName();
 }
 
 void QUaNode::addReference(const QUaReferenceType& ref, QUaNode* nodeTarget, const bool& isForward/* = true*/)
@@ -1054,16 +1271,13 @@ QUaNode * QUaNode::instantiateOptionalChild(
 	Q_ASSERT(st);
 	Q_UNUSED(st);
 	newInstance->m_nodeId = outOptionalNode;
+	newInstance->m_qUaServer->m_hashNodes[outOptionalNode] = newInstance;
 	// need to set parent and browse name
 	auto browseName = QUaQualifiedName(childName);
 	newInstance->setParent(parent);
 	newInstance->setObjectName(browseName);
 	Q_ASSERT(!parent->browseChild(browseName));
-	uint key = qHash(browseName);
-	parent->m_browseCache[key] = newInstance;
-	QObject::connect(newInstance, &QObject::destroyed, parent, [parent, key]() {
-		parent->m_browseCache.remove(key);
-	});
+	parent->addChildToIndex(newInstance, browseName);
 	// emit child added to parent
 	emit parent->childAdded(newInstance);
 	// success
@@ -134,6 +134,10 @@ public:
 
 	QUaServer* server() const;
 
+	// deletes this node and all its children in a single pass, cheaper than delete for large subtrees
+	// NOTE : this instance is deleted, do not use it afterwards
+	void deleteSubtree();
+
 	// Attributes API
 
 	virtual QUaLocalizedText displayName() const;
@@ -143,7 +147,7 @@ public:
 	void setDescription(const QUaLocalizedText& description);
 
 	quint32 writeMask() const;
-	void setWriteMask(const quint32& writeMask);
+	virtual void setWriteMask(const quint32& writeMask);
 
 	QUaNodeId nodeId() const;
 	QString nodeClass() const;
@@ -318,12 +322,31 @@ private:
 	static QHash<QUaNodeId, QUaQualifiedName> m_hashTypeBrowseNames;
 	// with new open62541, browseName is inmutable and reading it is kind of expensive
 	QUaQualifiedName m_browseName;
-	// browse hierarchical children cache
-	// NOTE : use uint as key because is cheaper to cache in QObject::destroyed
-	// lambda callback than the browseName. We need to cache because by the time the
-	// QUaNode destructor is called, the browseName is already unavailable from open62541
-	// TODO : consider removing after testing new open62541 tree implementation
-	QHash<uint, QUaNode*> m_browseCache;
+	// ordered hierarchical children index, maintained by the parent without signal connections
+	// NOTE : we need to cache because by the time the QUaNode destructor is called, 
+	// the browseName is already unavailable from open62541
+	QVector<QUaNode*> m_children;
+	// browse name lookup, only built once a node has many children
+	QHash<QUaQualifiedName, QUaNode*> m_childrenByName;
+	QUaNode* m_indexParent;
+	void addChildToIndex(QUaNode* child, const QUaQualifiedName& browseName);
+	void removeChildFromIndex(QUaNode* child);
+	// lazy instantiation, true if some children were left without C++ instance
+	bool m_childrenLazy;
+	// set by deleteSubtree, nodestore cleanup already done
+	bool m_subtreeDeleted;
+	// cache of nodeBrowsePath, only set if whole branch is in the children index
+	mutable QUaBrowsePath m_nodeBrowsePath;
+	// true if this node or a descendant has a cached browse path, limits invalidation
+	mutable bool m_nodeBrowsePathInBranch;
+	void invalidateNodeBrowsePath();
+	QUaNode* materializeChild(const UA_NodeId& childNodeId, const QUaQualifiedName& browseName);
+	QUaNode* materializeChild(const QUaQualifiedName& browseName);
+	void     materializeChildren();
+	// links in the server's per-type instance list
+	const QMetaObject* m_typeMetaObject;
+	QUaNode* m_typePrev;
+	QUaNode* m_typeNext;
 
 	// Static Helpers
 
@@ -33,9 +33,12 @@
 #endif // UA_ENABLE_SUBSCRIPTIONS_ALARMS_CONDITIONS
 
 #include <QMetaProperty>
+#include <QTimerEvent>
+#include <QtMath>
 #include <QTimer>
 
 #define QUA_MAX_LOG_MESSAGE_SIZE 1024
+#define QUA_INTERN_PRUNE_MIN     1024
 
 UA_StatusCode QUaServer::uaConstructor(UA_Server       * server, 
 	                                   const UA_NodeId * sessionId, 
@@ -65,8 +68,8 @@ UA_StatusCode QUaServer::uaConstructor(UA_Server       * server,
 	// get method from type constructors map and call it
 	Q_ASSERT(srv->m_hashConstructors.contains(*typeNodeId));
 	auto st = srv->m_hashConstructors[*typeNodeId](nodeId, nodeContext);
-	// emit new instance signal if appropriate
-	if (srv->m_hashSignalers.contains(*typeNodeId))
+	// emit new instance signal if appropriate (no instance for lite or lazy nodes)
+	if (*nodeContext && srv->m_hashSignalers.contains(*typeNodeId))
 	{
 		auto signaler = srv->m_hashSignalers.value(*typeNodeId);
 #ifdef QT_DEBUG 
@@ -120,6 +123,8 @@ void QUaServer::uaDestructor(UA_Server       * server,
 	// early exit if not convertible (this call was triggered by ~QUaNode)
 	if (!node)
 	{
+		// or lite variable deleted along with its parent
+		srv->releaseLiteHandle(*nodeId);
 		return;
 	}
 	// handle events if enabled
@@ -199,6 +204,11 @@ UA_StatusCode QUaServer::uaConstructor(
 	const QMetaObject &metaObject
 )
 {
+	// lite variables have no C++ instance
+	if (server->m_liteCreating)
+	{
+		return UA_STATUSCODE_GOOD;
+	}
 	// get parent node id
 	UA_NodeId topBoundParentNodeId = QUaNode::getParentNodeId(*nodeId, server->m_server);
 	// find top level node which is bound (bound := NodeId context == QUaNode instance)
@@ -239,23 +249,23 @@ UA_StatusCode QUaServer::uaConstructor(
 		UA_NodeId_clear(&topBoundParentNodeId); // clear old
 		topBoundParentNodeId = tmpParentNodeId; // shallow copy
 	}
+	// lazy instantiation, children of new instances are instantiated on demand
+	// (see QUaNode::materializeChild), unless a callback for the type is registered
+	if (server->m_lazyInstantiation && parentContext)
+	{
+		UA_NodeId lazyParentNodeId = QUaNode::getParentNodeId(*nodeId, server->m_server);
+		bool isDirectChild = UA_NodeId_equal(&topBoundParentNodeId, &lazyParentNodeId);
+		UA_NodeId_clear(&lazyParentNodeId);
+		UA_NodeId typeNodeId = server->m_mapTypes.value(QString(metaObject.className()), UA_NODEID_NULL);
+		if (!isDirectChild && !server->m_hashSignalers.contains(typeNodeId))
+		{
+			UA_NodeId_clear(&topBoundParentNodeId);
+			return UA_STATUSCODE_GOOD;
+		}
+	}
 	// create new instance (and bind it to UA, in base types happens in constructor, 
 	// in derived class is done by QOpcUaServerNodeFactory)
-	Q_ASSERT_X(metaObject.constructorCount() > 0, "QUaServer::uaConstructor", 
-		"Failed instantiation. No matching Q_INVOKABLE constructor with signature "
-		"CONSTRUCTOR(QUaServer *server) found.");
-	// NOTE : to simplify user API, we minimize QUaNode arguments to just a QUaServer 
-	// reference we temporarily store in the QUaServer reference the UA_NodeId and 
-	// QMetaObject values needed to instantiate the new node.
-	server->m_newNodeNodeId     = nodeId;
-	server->m_newNodeMetaObject = &metaObject;
-	// instantiate new C++ node, m_newNodeNodeId and m_newNodeMetaObject only meant to be used during this call
-	auto * pQObject = metaObject.newInstance(Q_ARG(QUaServer*, server));
-	Q_ASSERT_X(pQObject, "QUaServer::uaConstructor", 
-		"Failed instantiation. No matching Q_INVOKABLE constructor with signature "
-		"CONSTRUCTOR(QUaServer *server) found.");
-	auto* newInstance = qobject_cast<QUaNode*>(pQObject);
-	Q_CHECK_PTR(newInstance);
+	auto* newInstance = server->instantiateNode(nodeId, metaObject);
 	if (!newInstance)
 	{
 		UA_NodeId_clear(&topBoundParentNodeId);
@@ -266,6 +276,7 @@ UA_StatusCode QUaServer::uaConstructor(
 	// after calling the UA constructor
 	*nodeContext = static_cast<void*>(newInstance);
 	newInstance->m_nodeId = *nodeId;
+	server->m_hashNodes[*nodeId] = newInstance;
 	// need to set parent if direct parent is already bound bacause its constructor has already been called
 	UA_NodeId directParentNodeId = QUaNode::getParentNodeId(*nodeId, server->m_server);
 	if (parentContext && UA_NodeId_equal(&topBoundParentNodeId, &directParentNodeId))
@@ -274,11 +285,7 @@ UA_StatusCode QUaServer::uaConstructor(
 		newInstance->setParent(parentContext);
 		newInstance->setObjectName(browseName);
 		Q_ASSERT(!parentContext->browseChild(browseName));
-		uint key = qHash(browseName);
-		parentContext->m_browseCache[key] = newInstance;
-		QObject::connect(newInstance, &QObject::destroyed, parentContext, [parentContext, key]() {
-			parentContext->m_browseCache.remove(key);
-		});	
+		parentContext->addChildToIndex(newInstance, browseName);
 		// emit child added to parent
 		emit parentContext->childAdded(newInstance);
 	}
@@ -288,6 +295,31 @@ UA_StatusCode QUaServer::uaConstructor(
 	return UA_STATUSCODE_GOOD;
 }
 
+QUaNode* QUaServer::instantiateNode(const UA_NodeId* nodeId, const QMetaObject& metaObject)
+{
+	Q_ASSERT_X(metaObject.constructorCount() > 0, "QUaServer::instantiateNode", 
+		"Failed instantiation. No matching Q_INVOKABLE constructor with signature "
+		"CONSTRUCTOR(QUaServer *server) found.");
+	// NOTE : to simplify user API, we minimize QUaNode arguments to just a QUaServer 
+	// reference we temporarily store in the QUaServer reference the UA_NodeId and 
+	// QMetaObject values needed to instantiate the new node.
+	// NOTE : could be called while constructing another instance, so restore afterwards
+	auto oldNodeId     = m_newNodeNodeId;
+	auto oldMetaObject = m_newNodeMetaObject;
+	m_newNodeNodeId     = nodeId;
+	m_newNodeMetaObject = &metaObject;
+	// instantiate new C++ node, m_newNodeNodeId and m_newNodeMetaObject only meant to be used during this call
+	auto * pQObject = metaObject.newInstance(Q_ARG(QUaServer*, this));
+	m_newNodeNodeId     = oldNodeId;
+	m_newNodeMetaObject = oldMetaObject;
+	Q_ASSERT_X(pQObject, "QUaServer::instantiateNode", 
+		"Failed instantiation. No matching Q_INVOKABLE constructor with signature "
+		"CONSTRUCTOR(QUaServer *server) found.");
+	auto* newInstance = qobject_cast<QUaNode*>(pQObject);
+	Q_CHECK_PTR(newInstance);
+	return newInstance;
+}
+
 // [STATIC]
 UA_StatusCode QUaServer::methodCallback(
 	UA_Server        *server,
@@ -965,6 +997,16 @@ QUaServer::QUaServer(QObject* parent/* = 0*/)
 {
 	// defaults
 	m_port = 4840;
+	m_iterEventDriven = false;
+	m_updateDepth      = 0;
+	m_updateBatch      = 0;
+	m_updateCommitting = false;
+	m_liteCreating      = false;
+	m_liteInternalWrite = false;
+	m_lazyInstantiation = false;
+	m_internedPrune     = QUA_INTERN_PRUNE_MIN;
+	m_iterThreaded = false;
+	m_iterThread   = nullptr;
 	m_anonymousLoginAllowed = true;
 	m_byteCertificate = QByteArray();
 	m_byteCertificateInternal = QByteArray();
@@ -995,28 +1037,104 @@ void QUaServer::addChange(const QUaChangeStructureDataType& change)
 {
 	// NOTE : do not check if server is running because we might wanna
 	//        historize offline events
-	if (m_listChanges.contains(change))
+	if (m_changesOverflow)
 	{
-		return;
+		m_changesOverflowVerb |= change.m_uiVerb;
 	}
-	m_listChanges.append(change);
+	else
+	{
+		if (m_setChanges.contains(change))
+		{
+			return;
+		}
+		m_setChanges.insert(change);
+		m_listChanges.append(change);
+		// too many changes, collapse them into a single one when triggering
+		if (m_changeMaxCount > 0 && m_listChanges.count() > m_changeMaxCount)
+		{
+			m_changesOverflow     = true;
+			m_changesOverflowVerb = 0;
+			for (const auto& bufferedChange : m_listChanges)
+			{
+				m_changesOverflowVerb |= bufferedChange.m_uiVerb;
+			}
+			m_listChanges.clear();
+			m_setChanges.clear();
+		}
+	}
+	this->scheduleChangeEvent();
+}
+
+void QUaServer::scheduleChangeEvent()
+{
 	// if trigger already scheduled, then ealry exit
-	if (m_changeEventSignaler.processing())
+	if (m_changeEventSignaler.processing() || m_changeEventTimer.isActive())
+	{
+		return;
+	}
+	// respect min interval since last trigger
+	qint64 wait = m_changeMinInterval > 0 && m_changeLastEmit.isValid() ?
+		m_changeMinInterval - m_changeLastEmit.elapsed() : 0;
+	if (wait > 0)
 	{
+		m_changeEventTimer.start(static_cast<int>(wait));
 		return;
 	}
 	// exec trigger on next event loop iteration
 	m_changeEventSignaler.execLater([this]() {
-		// trigger
-		auto time = QDateTime::currentDateTimeUtc();
-		m_changeEvent->setChanges(m_listChanges);
-		m_changeEvent->setTime(time);
-		m_changeEvent->setReceiveTime(time);
-		m_changeEvent->trigger();
-		// clean list of changes buffer
-		m_listChanges.clear();
+		this->triggerChangeEvent();
 	});
 }
+
+void QUaServer::triggerChangeEvent()
+{
+	if (m_changesOverflow)
+	{
+		QUaChangeStructureDataType change(
+			this->objectsFolder()->nodeId(),
+			this->objectsFolder()->typeDefinitionNodeId(),
+			QUaChangeVerb::ReferenceAdded
+		);
+		change.m_uiVerb = m_changesOverflowVerb;
+		m_listChanges.append(change);
+	}
+	if (m_listChanges.isEmpty())
+	{
+		return;
+	}
+	// trigger
+	auto time = QDateTime::currentDateTimeUtc();
+	m_changeEvent->setChanges(m_listChanges);
+	m_changeEvent->setTime(time);
+	m_changeEvent->setReceiveTime(time);
+	m_changeEvent->trigger();
+	// clean list of changes buffer
+	m_listChanges.clear();
+	m_setChanges.clear();
+	m_changesOverflow     = false;
+	m_changesOverflowVerb = 0;
+	m_changeLastEmit.start();
+}
+
+int QUaServer::modelChangeMinInterval() const
+{
+	return m_changeMinInterval;
+}
+
+void QUaServer::setModelChangeMinInterval(const int& interval)
+{
+	m_changeMinInterval = (std::max)(0, interval);
+}
+
+int QUaServer::modelChangeMaxCount() const
+{
+	return m_changeMaxCount;
+}
+
+void QUaServer::setModelChangeMaxCount(const int& maxCount)
+{
+	m_changeMaxCount = (std::max)(0, maxCount);
+}
 #endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
 
 #ifdef UA_ENABLE_SUBSCRIPTIONS_ALARMS_CONDITIONS
@@ -1189,6 +1307,11 @@ void QUaServer::resetConfig()
 	// custom instance declaration NodeId mechanism
 	config->nodeLifecycle.generateChildNodeId = &QUaServer::generateChildNodeId;
 
+#ifdef UA_ENABLE_SUBSCRIPTIONS
+	// track monitored variables
+	config->monitoredItemRegisterCallback = &QUaBaseVariable::onMonitoredItemRegister;
+#endif // UA_ENABLE_SUBSCRIPTIONS
+
 	Q_UNUSED(st);
 }
 
@@ -1370,6 +1493,12 @@ void QUaServer::setupServer()
 	m_changeEvent->setSourceName(tr("Server"));
 	m_changeEvent->setMessage(tr("Node added or removed."));
 	m_changeEvent->setSeverity(1);
+	m_changesOverflow     = false;
+	m_changesOverflowVerb = 0;
+	m_changeMinInterval   = 0;
+	m_changeMaxCount      = 0;
+	m_changeEventTimer.setSingleShot(true);
+	QObject::connect(&m_changeEventTimer, &QTimer::timeout, this, &QUaServer::triggerChangeEvent);
 #endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
 
 #ifdef UA_ENABLE_SUBSCRIPTIONS_ALARMS_CONDITIONS
@@ -1447,6 +1576,26 @@ QUaServer::~QUaServer()
 	{
 		delete this->children().at(0);
 	}
+	// discard values not yet written
+	for (auto& queued : m_valueQueue)
+	{
+		UA_NodeId_clear(&queued.nodeId);
+		UA_Variant_clear(&queued.value);
+	}
+	m_valueQueue.clear();
+	// discard batched writes not yet committed
+	for (auto& wv : m_updateWrites)
+	{
+		UA_WriteValue_clear(&wv);
+	}
+	m_updateWrites.clear();
+	// lite variable nodes are deleted with the server, only node ids to cleanup
+	for (auto& liteNodeId : m_liteNodes)
+	{
+		UA_NodeId_clear(&liteNodeId);
+	}
+	m_liteNodes.clear();
+	m_liteHandles.clear();
 	// cleanup open62541
 	UA_Server_delete(this->m_server);
 }
@@ -1585,6 +1734,12 @@ void QUaServer::start()
 	{
 		return;
 	}
+	// move whole server to its own thread, then start from there
+	if (m_iterThreaded && !m_iterThread)
+	{
+		this->startIterateThread();
+		return;
+	}
 	// reset config before starting
 	this->resetConfig();
 	// start open62541 server
@@ -1592,12 +1747,27 @@ void QUaServer::start()
 	Q_ASSERT(st == UA_STATUSCODE_GOOD);
 	Q_UNUSED(st);
 	m_running = true;
+	// event driven iterations
+	if (m_iterEventDriven)
+	{
+		m_iterWaitTimer.setSingleShot(true);
+		QObject::connect(&m_iterWaitTimer, &QTimer::timeout, this, 
+			&QUaServer::iterateOnEvent, Qt::QueuedConnection);
+		// first iteration creates socket notifiers and arms timer
+		m_iterWaitTimer.start(0);
+		// emit event
+		emit this->isRunningChanged(m_running);
+		return;
+	}
+	m_iterWaitTimer.setSingleShot(false);
 	QObject::connect(&m_iterWaitTimer, &QTimer::timeout, this,
 	[this]() {
 		// do not iterate if asked to stop
 		if (!m_running) { return; }
 		// iterate and restart
 		m_iterWaitTimer.stop();
+		// write values queued from other threads
+		this->processValueQueue();
 		// NOTE : any other delay or not waitInternal make subscribing to
 		//        events painfully slow
 		UA_Server_run_iterate(m_server, true);
@@ -1611,6 +1781,12 @@ void QUaServer::start()
 
 void QUaServer::stop()
 {
+	// stop in server thread and move server back to the calling thread
+	if (m_iterThread && QThread::currentThread() != m_iterThread)
+	{
+		this->stopIterateThread();
+		return;
+	}
 	if (!m_running)
 	{
 		return;
@@ -1618,6 +1794,7 @@ void QUaServer::stop()
 	m_running = false;
 	m_iterWaitTimer.stop();
 	m_iterWaitTimer.disconnect();
+	this->clearSocketNotifiers();
 	UA_Server_run_shutdown(m_server);
 	// [FIX] force remove channels and sessions
 	// NOTE : cannot use UA_Server_cleanup because it only removes timedout sessions
@@ -1651,195 +1828,904 @@ void QUaServer::setIsRunning(const bool& running)
 	}
 }
 
-quint16 QUaServer::maxSecureChannels() const
-{
-	return m_maxSecureChannels;
-}
-
-void QUaServer::setMaxSecureChannels(const quint16& maxSecureChannels)
+void QUaServer::queueValueInternal(
+	const QUaNodeId     &nodeId,
+	UA_Variant          &value,
+	const QUaStatusCode &statusCode,
+	const QDateTime     &sourceTimestamp)
 {
-	m_maxSecureChannels = maxSecureChannels;
-	emit this->maxSecureChannelsChanged(m_maxSecureChannels);
+	Q_ASSERT(!nodeId.isNull());
+	QUaQueuedValue queued;
+	// NOTE : variable is resolved in server thread, could be deleted before queue is processed
+	queued.nodeId = nodeId.toUaNodeId();
+	// NOTE : takes ownership of value
+	queued.value  = value;
+	UA_Variant_init(&value);
+	queued.status = statusCode;
+	queued.sourceTimestamp = 0;
+	if (sourceTimestamp.isValid())
+	{
+		QUaTypesConverter::uaVariantFromQVariantScalar(sourceTimestamp, &queued.sourceTimestamp);
+	}
+	QMutexLocker locker(&m_valueQueueMutex);
+	bool wasEmpty = m_valueQueue.isEmpty();
+	m_valueQueue.append(queued);
+	// schedule processing in case server is not iterating (stopped or waiting for events)
+	if (!wasEmpty)
+	{
+		return;
+	}
+	QMetaObject::invokeMethod(this, [this]() {
+		this->processValueQueue();
+	}, Qt::QueuedConnection);
 }
 
-quint16 QUaServer::maxSessions() const
+void QUaServer::processValueQueue()
 {
-	return m_maxSessions;
+	// take whole batch to release lock as soon as possible
+	QVector<QUaQueuedValue> queue;
+	m_valueQueueMutex.lock();
+	queue.swap(m_valueQueue);
+	m_valueQueueMutex.unlock();
+	for (auto& queued : queue)
+	{
+		auto var = qobject_cast<QUaBaseVariable*>(QUaNode::getNodeContext(queued.nodeId, m_server));
+		// variable deleted in the meantime
+		if (!var)
+		{
+			UA_NodeId_clear(&queued.nodeId);
+			UA_Variant_clear(&queued.value);
+			continue;
+		}
+		QDateTime sourceTimestamp = queued.sourceTimestamp != 0 ?
+			QUaTypesConverter::uaVariantToQVariantScalar<QDateTime, UA_DateTime>(&queued.sourceTimestamp) :
+			QDateTime();
+		// if data type differs, fallback to conversion rules of setValue
+		// NOTE : empty value has no type to compare, write it as is
+		if (!UA_Variant_isEmpty(&queued.value) &&
+			var->m_dataType != QUaTypesConverter::uaTypeToQType(queued.value.type))
+		{
+			var->setValue(
+				QUaTypesConverter::uaVariantToQVariant(queued.value),
+				queued.status,
+				sourceTimestamp
+			);
+		}
+		else
+		{
+			// virtual, so deadband, batch updates and subclass overrides apply (takes ownership)
+			var->setValueDirect(queued.value, queued.status, sourceTimestamp, QDateTime());
+		}
+		UA_NodeId_clear(&queued.nodeId);
+		UA_Variant_clear(&queued.value);
+	}
 }
 
-void QUaServer::setMaxSessions(const quint16& maxSessions)
+void QUaServer::beginUpdate()
 {
-	m_maxSessions = maxSessions;
-	emit this->maxSessionsChanged(m_maxSessions);
+	m_updateDepth++;
 }
 
-void QUaServer::registerTypeInternal(
-	const QMetaObject& metaObject, 
-	const QUaNodeId& nodeId/* = ""*/
-)
+void QUaServer::commitUpdate()
 {
-	// check if OPC UA relevant
-	if (!metaObject.inherits(&QUaNode::staticMetaObject))
+	Q_ASSERT_X(m_updateDepth > 0, "QUaServer::commitUpdate", "Called without beginUpdate");
+	if (m_updateDepth <= 0)
 	{
-		Q_ASSERT_X(false, "QUaServer::registerType", "Unsupported base class");
 		return;
 	}
-	// check if already registered
-	QString   strClassName = QString(metaObject.className());
-	UA_NodeId newTypeNodeId = m_mapTypes.value(strClassName, UA_NODEID_NULL);
-	if (!UA_NodeId_isNull(&newTypeNodeId))
+	// only outermost commit writes
+	m_updateDepth--;
+	if (m_updateDepth > 0 || m_updateWrites.isEmpty())
 	{
-		Q_ASSERT(m_mapTypes.contains(strClassName));
 		return;
 	}
-	// create new type browse name
-	UA_QualifiedName browseName;
-	browseName.namespaceIndex = 0;
-	browseName.name = QUaTypesConverter::uaStringFromQString(strClassName);
-	// check if base class is registered
-	QString strBaseClassName = QString(metaObject.superClass()->className());
-	if (!m_mapTypes.contains(strBaseClassName))
+	// write all in a single service call (single lock and nodestore pass)
+	UA_WriteRequest request;
+	UA_WriteRequest_init(&request);
+	request.nodesToWrite     = m_updateWrites.data();
+	request.nodesToWriteSize = static_cast<size_t>(m_updateWrites.count());
+	UA_WriteResponse response;
+	UA_WriteResponse_init(&response);
+	// mask as internal write to avoid emitting valueChange signal on QUaBaseVariable::onWrite
+	m_updateCommitting = true;
+#if UA_MULTITHREADING >= 100
+	UA_LOCK(m_server->serviceMutex);
+#endif // UA_MULTITHREADING
+	Service_Write(m_server, &m_server->adminSession, &request, &response);
+#if UA_MULTITHREADING >= 100
+	UA_UNLOCK(m_server->serviceMutex);
+#endif // UA_MULTITHREADING
+	m_updateCommitting = false;
+	Q_ASSERT(response.responseHeader.serviceResult == UA_STATUSCODE_GOOD);
+#ifdef QT_DEBUG 
+	for (size_t i = 0; i < response.resultsSize; i++)
 	{
-		// recursive
-		this->registerTypeInternal(*metaObject.superClass());
+		// NOTE : variable might have been deleted before commit
+		Q_ASSERT(response.results[i] == UA_STATUSCODE_GOOD ||
+			     response.results[i] == UA_STATUSCODE_BADNODEIDUNKNOWN);
 	}
-	Q_ASSERT_X(m_mapTypes.contains(strBaseClassName), "QUaServer::registerType", "Base object type not registered.");
-	// check if requested node id defined
-	if (!nodeId.isNull())
+#endif // QT_DEBUG 
+	// cleanup (request does not own the array)
+	UA_WriteResponse_clear(&response);
+	for (auto& wv : m_updateWrites)
 	{
-		// check if requested node id exists
-		bool isUsed = this->isNodeIdUsed(nodeId);
-		Q_ASSERT_X(!isUsed, "QUaServer::registerType", "Requested NodeId already exists");
-		if (isUsed)
-		{
-			UA_QualifiedName_clear(&browseName);
-			return;
-		}
+		UA_WriteValue_clear(&wv);
 	}
-	UA_NodeId reqNodeId = nodeId;
-	// check if variable or object
-	if (metaObject.inherits(&QUaBaseDataVariable::staticMetaObject))
+	m_updateWrites.clear();
+	// invalidate pending write indexes of variables
+	m_updateBatch++;
+}
+
+bool QUaServer::isUpdating() const
+{
+	return m_updateDepth > 0;
+}
+
+void QUaServer::setPollProvider(const std::function<QVariantList(const QVector<QUaBaseVariable*>&)>& provider)
+{
+	m_pollProvider = provider;
+}
+
+void QUaServer::addPolledVariable(QUaBaseVariable* variable, const int& interval/* = -1*/)
+{
+	Q_CHECK_PTR(variable);
+	if (!variable)
 	{
-		// create variable type attributes
-		UA_VariableTypeAttributes vtAttr = UA_VariableTypeAttributes_default;
-		// set node attributes		  
-		QByteArray byteDisplayName = strClassName.toUtf8();
-		vtAttr.displayName = UA_LOCALIZEDTEXT((char*)"", byteDisplayName.data());
-		QByteArray byteDescription = QString("").toUtf8();
-		vtAttr.description = UA_LOCALIZEDTEXT((char*)"", byteDescription.data());
-		// add new variable type
-		auto st = UA_Server_addVariableTypeNode(m_server,
-			reqNodeId,                                 // requested nodeId
-			m_mapTypes.value(strBaseClassName, UA_NODEID_NUMERIC(0, UA_NS0ID_BASEDATAVARIABLETYPE)), // parent (variable type)
-			UA_NODEID_NUMERIC(0, UA_NS0ID_HASSUBTYPE), // parent relation with child
-			browseName,
-			UA_NODEID_NULL,                            // typeDefinition ??
-			vtAttr,
-			(void*)this,                               // context : server instance where type was registered
-			&newTypeNodeId);                           // new variable type id
-		Q_ASSERT(st == UA_STATUSCODE_GOOD);
-		Q_UNUSED(st);
+		return;
 	}
-	else
+	// re-add if already polled, in case interval changed
+	this->removePolledVariable(variable);
+	int msInterval = interval > 0 ? interval : 
+		qCeil(variable->minimumSamplingInterval());
+	msInterval = msInterval > 0 ? msInterval : 1000;
+	// start timer for new group
+	QUaPollGroup& group = m_pollGroups[msInterval];
+	if (group.variables.isEmpty())
 	{
-		Q_ASSERT(metaObject.inherits(&QUaBaseObject::staticMetaObject));
-		// create object type attributes
-		UA_ObjectTypeAttributes otAttr = UA_ObjectTypeAttributes_default;
-		// set node attributes		  
-		QByteArray byteDisplayName = strClassName.toUtf8();
-		otAttr.displayName = UA_LOCALIZEDTEXT((char*)"", byteDisplayName.data());
-		QByteArray byteDescription = QString("").toUtf8();
-		otAttr.description = UA_LOCALIZEDTEXT((char*)"", byteDescription.data());
-		// add new object type
-		auto st = UA_Server_addObjectTypeNode(m_server,
-			reqNodeId,                                 // requested nodeId
-			m_mapTypes.value(strBaseClassName, UA_NODEID_NUMERIC(0, UA_NS0ID_BASEOBJECTTYPE)), // parent (object type)
-			UA_NODEID_NUMERIC(0, UA_NS0ID_HASSUBTYPE), // parent relation with child
-			browseName,
-			otAttr,
-			(void*)this,                               // context : server instance where type was registered
-			&newTypeNodeId);                           // new object type id
-		Q_ASSERT(st == UA_STATUSCODE_GOOD);
-		Q_UNUSED(st);
+		group.timerId = this->startTimer(msInterval, Qt::PreciseTimer);
+		Q_ASSERT(group.timerId != 0);
+		m_pollTimers[group.timerId] = msInterval;
 	}
-	// clean up
-	UA_QualifiedName_clear(&browseName);
-	UA_NodeId_clear(&reqNodeId);
-	// add to registered types map
-	m_mapTypes.insert(strClassName, newTypeNodeId);
-	m_hashMetaObjects.insert(strClassName, metaObject);
-	// register for default mandatory children and so on
-	// in case our custom type inherits from a spec type
-	// which contains mandatory children
-	this->registerTypeDefaults(newTypeNodeId, metaObject);
-	// register constructor/destructor
-	this->registerTypeLifeCycle(newTypeNodeId, metaObject);
-	// register meta-enums
-	this->registerMetaEnums(metaObject);
-	// register meta-properties
-	this->addMetaProperties(metaObject);
-	// register meta-methods (only if object class, or NOT variable class)
-	if (!metaObject.inherits(&QUaBaseDataVariable::staticMetaObject))
+	// NOTE : ~QUaBaseVariable removes itself
+	QUaPollEntry entry;
+	entry.interval = msInterval;
+	entry.index    = group.variables.count();
+	group.variables.append(variable);
+	m_pollEntries[variable] = entry;
+}
+
+void QUaServer::removePolledVariable(QUaBaseVariable* variable)
+{
+	auto entry = m_pollEntries.find(variable);
+	if (entry == m_pollEntries.end())
 	{
-		this->addMetaMethods(metaObject);
+		return;
+	}
+	QUaPollGroup& group = m_pollGroups[entry.value().interval];
+	// swap with last to remove in constant time
+	int index = entry.value().index;
+	auto last = group.variables.last();
+	group.variables[index] = last;
+	m_pollEntries[last].index = index;
+	group.variables.removeLast();
+	// stop timer if group is empty
+	if (group.variables.isEmpty())
+	{
+		this->killTimer(group.timerId);
+		m_pollTimers.remove(group.timerId);
+		m_pollGroups.remove(entry.value().interval);
 	}
+	m_pollEntries.erase(entry);
 }
 
-QList<QUaNode*> QUaServer::typeInstances(const QMetaObject& metaObject)
+void QUaServer::pollGroup(const int& interval)
 {
-	QList<QUaNode*> retList;
-	// check if OPC UA relevant
-	if (!metaObject.inherits(&QUaNode::staticMetaObject))
+	if (!m_pollProvider || !m_pollGroups.contains(interval))
 	{
-		Q_ASSERT_X(false, "QUaServer::typeInstances", "Unsupported base class. It must derive from QUaNode");
-		return retList;
+		return;
 	}
-	// try to get typeNodeId, if null, then register it
-	UA_NodeId typeNodeId = this->typeIdByMetaObject(metaObject);
-	Q_ASSERT(!UA_NodeId_isNull(&typeNodeId));
-	// make ua browse
-	auto refTypeId = UA_NODEID_NUMERIC(0, UA_NS0ID_HASTYPEDEFINITION);
-	QList<UA_NodeId> retRefSet;
-	UA_BrowseDescription* bDesc = UA_BrowseDescription_new();
-	UA_NodeId_copy(&typeNodeId, &bDesc->nodeId);
-	bDesc->browseDirection = UA_BROWSEDIRECTION_INVERSE; //TypeDefinitionOf
-	bDesc->includeSubtypes = true;
-	bDesc->referenceTypeId = refTypeId;
-	bDesc->resultMask = UA_BROWSERESULTMASK_REFERENCETYPEID;
-	// browse
-	UA_BrowseResult bRes = UA_Server_browse(m_server, 0, bDesc);
-	Q_ASSERT(bRes.statusCode == UA_STATUSCODE_GOOD);
-	while (bRes.referencesSize > 0)
+	// NOTE : implicitly shared, only detaches if provider adds or removes polled variables
+	QVector<QUaBaseVariable*> variables = m_pollGroups[interval].variables;
+	QVariantList values = m_pollProvider(variables);
+	Q_ASSERT(values.count() == variables.count());
+	int count = (std::min)(values.count(), variables.count());
+	// write all values at once
+	this->beginUpdate();
+	for (int i = 0; i < count; i++)
 	{
-		for (size_t i = 0; i < bRes.referencesSize; i++)
+		const QVariant& value = values.at(i);
+		QUaBaseVariable* variable = variables.at(i);
+		// deleted variables remove themselves from polling
+		if (!value.isValid() || !m_pollEntries.contains(variable))
 		{
-			UA_ReferenceDescription rDesc = bRes.references[i];
-			Q_ASSERT(UA_NodeId_equal(&rDesc.referenceTypeId, &refTypeId));
-			UA_NodeId nodeId/* = rDesc.nodeId.nodeId*/;
-			UA_NodeId_copy(&rDesc.nodeId.nodeId, &nodeId);
-			retRefSet << nodeId;
+			continue;
 		}
-		UA_BrowseResult_deleteMembers(&bRes);
-		bRes = UA_Server_browseNext(m_server, true, &bRes.continuationPoint);
+		// same type, no need to infer or convert type
+		if (static_cast<QMetaType::Type>(value.userType()) == variable->m_dataType)
+		{
+			auto uaVar = QUaTypesConverter::uaVariantFromQVariant(value);
+			variable->setValueDirect(uaVar, UA_STATUSCODE_GOOD, QDateTime(), QDateTime());
+			continue;
+		}
+		variable->setValue(value);
 	}
-	// cleanup
-	UA_BrowseDescription_deleteMembers(bDesc);
-	UA_BrowseDescription_delete(bDesc);
-	UA_BrowseResult_deleteMembers(&bRes);
-	// get QUaNode references
-	for (int i = 0; i < retRefSet.count(); i++)
+	this->commitUpdate();
+}
+
+void QUaServer::timerEvent(QTimerEvent* event)
+{
+	auto interval = m_pollTimers.find(event->timerId());
+	if (interval == m_pollTimers.end())
+	{
+		QObject::timerEvent(event);
+		return;
+	}
+	this->pollGroup(interval.value());
+}
+
+int QUaServer::addLiteVariable(
+	QUaNode                *parentNode,
+	const QUaQualifiedName &browseName,
+	const QVariant         &value,
+	const QUaNodeId        &nodeId
+)
+{
+	Q_CHECK_PTR(parentNode);
+	if (!parentNode)
+	{
+		return -1;
+	}
+	// check nodestore, lite and non-instantiated children are not in the C++ index
+	UA_QualifiedName uaBrowseName = browseName;
+	UA_BrowsePathResult bRes = UA_Server_browseSimplifiedBrowsePath(
+		m_server, parentNode->m_nodeId, 1, &uaBrowseName);
+	bool browseNameUsed = bRes.statusCode == UA_STATUSCODE_GOOD && bRes.targetsSize > 0;
+	UA_BrowsePathResult_clear(&bRes);
+	UA_QualifiedName_clear(&uaBrowseName);
+	if (browseNameUsed)
+	{
+		Q_ASSERT_X(false, "QUaServer::addLiteVariable", "Requested BrowseName already exists in parent");
+		return -1;
+	}
+	if (!nodeId.isNull() && this->isNodeIdUsed(nodeId))
+	{
+		Q_ASSERT_X(false, "QUaServer::addLiteVariable", "Requested NodeId already exists");
+		return -1;
+	}
+	UA_VariableAttributes vAttr = UA_VariableAttributes_default;
+	if (value.isValid())
+	{
+		vAttr.value = QUaTypesConverter::uaVariantFromQVariant(value);
+		if (vAttr.value.type)
+		{
+			vAttr.dataType = vAttr.value.type->typeId;
+		}
+	}
+	// default displayName is browseName
+	QByteArray byteDisplayName = browseName.name().toUtf8();
+	vAttr.displayName = UA_LOCALIZEDTEXT((char*)"", byteDisplayName.data());
+	UA_QualifiedName uaBrowseName = browseName;
+	UA_NodeId reqNodeId = nodeId;
+	UA_NodeId referenceTypeId = QUaServer::getReferenceTypeId(
+		*parentNode->metaObject(), QUaBaseDataVariable::staticMetaObject);
+	UA_NodeId newNodeId;
+	// NOTE : skip C++ instantiation in QUaServer::uaConstructor
+	m_liteCreating = true;
+	auto st = UA_Server_addVariableNode(m_server,
+		reqNodeId,
+		parentNode->m_nodeId,
+		referenceTypeId,
+		uaBrowseName,
+		UA_NODEID_NUMERIC(0, UA_NS0ID_BASEDATAVARIABLETYPE),
+		vAttr,
+		nullptr,
+		&newNodeId);
+	m_liteCreating = false;
+	Q_ASSERT(st == UA_STATUSCODE_GOOD);
+	// cleanup
+	UA_Variant_clear(&vAttr.value);
+	UA_NodeId_clear(&reqNodeId);
+	UA_NodeId_clear(&referenceTypeId);
+	UA_QualifiedName_clear(&uaBrowseName);
+	if (st != UA_STATUSCODE_GOOD)
+	{
+		return -1;
+	}
+	// reuse free handle if any
+	int handle;
+	if (!m_liteFree.isEmpty())
+	{
+		handle = m_liteFree.takeLast();
+		m_liteNodes[handle] = newNodeId;
+	}
+	else
+	{
+		handle = m_liteNodes.count();
+		m_liteNodes << newNodeId;
+	}
+	m_liteHandles[newNodeId] = handle;
+	// trigger reference added, model change event
+#ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
+	if (parentNode->inAddressSpace())
+	{
+		this->addChange({
+			parentNode->nodeId(),
+			parentNode->typeDefinitionNodeId(),
+			QUaChangeVerb::ReferenceAdded
+		});
+	}
+#endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
+	return handle;
+}
+
+void QUaServer::removeLiteVariable(const int& handle)
+{
+	if (!this->isLiteVariable(handle))
+	{
+		return;
+	}
+	// NOTE : handle released by QUaServer::uaDestructor
+	UA_NodeId parentNodeId = QUaNode::getParentNodeId(m_liteNodes.at(handle), m_server);
+	auto st = UA_Server_deleteNode(m_server, m_liteNodes.at(handle), true);
+	Q_ASSERT(st == UA_STATUSCODE_GOOD);
+	Q_UNUSED(st);
+	Q_ASSERT(!this->isLiteVariable(handle));
+	// trigger reference deleted, model change event
+#ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
+	QUaNode* parent = this->nodeById(parentNodeId);
+	if (parent && parent->inAddressSpace())
+	{
+		this->addChange({
+			parent->nodeId(),
+			parent->typeDefinitionNodeId(),
+			QUaChangeVerb::ReferenceDeleted
+		});
+	}
+#endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
+	UA_NodeId_clear(&parentNodeId);
+}
+
+bool QUaServer::isLiteVariable(const int& handle) const
+{
+	return handle >= 0 && handle < m_liteNodes.count() &&
+		!UA_NodeId_isNull(&m_liteNodes.at(handle));
+}
+
+QUaNodeId QUaServer::liteVariableNodeId(const int& handle) const
+{
+	if (!this->isLiteVariable(handle))
+	{
+		return QUaNodeId();
+	}
+	return m_liteNodes.at(handle);
+}
+
+QVariant QUaServer::liteValue(const int& handle) const
+{
+	UA_Variant uaVar;
+	UA_Variant_init(&uaVar);
+	if (!this->liteValueInternal(handle, uaVar))
+	{
+		return QVariant();
+	}
+	QVariant retValue = QUaTypesConverter::uaVariantToQVariant(uaVar);
+	UA_Variant_clear(&uaVar);
+	return retValue;
+}
+
+bool QUaServer::setLiteValue(const int& handle, const QVariant& value)
+{
+	UA_Variant uaVar = QUaTypesConverter::uaVariantFromQVariant(value);
+	bool ok = this->setLiteValueInternal(handle, uaVar);
+	UA_Variant_clear(&uaVar);
+	return ok;
+}
+
+bool QUaServer::liteValueInternal(const int& handle, UA_Variant& value) const
+{
+	if (!this->isLiteVariable(handle))
+	{
+		return false;
+	}
+	auto st = UA_Server_readValue(m_server, m_liteNodes.at(handle), &value);
+	return st == UA_STATUSCODE_GOOD;
+}
+
+bool QUaServer::setLiteValueInternal(const int& handle, const UA_Variant& value)
+{
+	if (!this->isLiteVariable(handle))
+	{
+		return false;
+	}
+	// mask as internal write to avoid calling value changed callback
+	m_liteInternalWrite = true;
+	// NOTE : can fail for a value of a different type, caller gets false
+	auto st = UA_Server_writeValue(m_server, m_liteNodes.at(handle), value);
+	m_liteInternalWrite = false;
+	return st == UA_STATUSCODE_GOOD;
+}
+
+void QUaServer::setLiteValueChangedCallback(
+	const int& handle, 
+	const std::function<void(const int&, const QVariant&)>& callback)
+{
+	if (!this->isLiteVariable(handle))
+	{
+		return;
+	}
+	const UA_NodeId& nodeId = m_liteNodes.at(handle);
+	UA_ValueCallback valueCallback;
+	valueCallback.onRead  = nullptr;
+	valueCallback.onWrite = callback ? &QUaServer::onLiteWrite : nullptr;
+	auto st = UA_Server_setVariableNode_valueCallback(m_server, nodeId, valueCallback);
+	Q_ASSERT(st == UA_STATUSCODE_GOOD);
+	Q_UNUSED(st);
+	if (!callback)
+	{
+		m_liteCallbacks.remove(nodeId);
+		return;
+	}
+	m_liteCallbacks[nodeId] = { handle, callback };
+	// make writable
+	UA_Byte outAccessLevel;
+	st = UA_Server_readAccessLevel(m_server, nodeId, &outAccessLevel);
+	Q_ASSERT(st == UA_STATUSCODE_GOOD);
+	st = UA_Server_writeAccessLevel(m_server, nodeId, outAccessLevel | UA_ACCESSLEVELMASK_WRITE);
+	Q_ASSERT(st == UA_STATUSCODE_GOOD);
+}
+
+void QUaServer::onLiteWrite(
+	UA_Server             *server, 
+	const UA_NodeId       *sessionId,
+	void                  *sessionContext, 
+	const UA_NodeId       *nodeId,
+	void                  *nodeContext, 
+	const UA_NumericRange *range,
+	const UA_DataValue    *data)
+{
+	Q_UNUSED(sessionContext);
+	Q_UNUSED(nodeContext);
+	Q_UNUSED(range);
+	auto srv = QUaServer::getServerNodeContext(server);
+	Q_CHECK_PTR(srv);
+	if (!srv || srv->m_liteInternalWrite || !data->hasValue)
+	{
+		return;
+	}
+	auto iter = srv->m_liteCallbacks.find(*nodeId);
+	if (iter == srv->m_liteCallbacks.end())
+	{
+		return;
+	}
+	srv->m_currentSession = srv->m_hashSessions.contains(*sessionId) ?
+		srv->m_hashSessions[*sessionId] : nullptr;
+	// NOTE : copy in case callback removes the variable
+	auto liteCallback = iter.value();
+	liteCallback.callback(liteCallback.handle, 
+		QUaTypesConverter::uaVariantToQVariant(data->value));
+}
+
+void QUaServer::releaseLiteHandle(const UA_NodeId& nodeId)
+{
+	auto iter = m_liteHandles.find(nodeId);
+	if (iter == m_liteHandles.end())
+	{
+		return;
+	}
+	int handle = iter.value();
+	m_liteHandles.erase(iter);
+	m_liteCallbacks.remove(nodeId);
+	UA_NodeId_clear(&m_liteNodes[handle]);
+	m_liteFree << handle;
+}
+
+QUaBaseDataVariable* QUaServer::materializeLiteVariable(const int& handle)
+{
+	if (!this->isLiteVariable(handle))
+	{
+		return nullptr;
+	}
+	// NOTE : node id ownership is transferred to the new instance
+	UA_NodeId nodeId = m_liteNodes.at(handle);
+	UA_NodeId parentNodeId = QUaNode::getParentNodeId(nodeId, m_server);
+	QUaNode* parent = this->nodeById(parentNodeId);
+	UA_NodeId_clear(&parentNodeId);
+	auto* newInstance = qobject_cast<QUaBaseDataVariable*>(
+		this->instantiateNode(&nodeId, QUaBaseDataVariable::staticMetaObject));
+	if (!newInstance)
+	{
+		return nullptr;
+	}
+	// release handle, value callback was replaced by the C++ instance
+	m_liteCallbacks.remove(nodeId);
+	m_liteHandles.remove(nodeId);
+	m_liteNodes[handle] = UA_NODEID_NULL;
+	m_liteFree << handle;
+	// need to set parent and browse name
+	if (parent)
 	{
-		// when browsing ObjectsFolder there are children with null context (Server object and children)
-		QUaNode* node = QUaNode::getNodeContext(retRefSet[i], m_server);
-		if (node)
+		auto browseName = QUaNode::getBrowseName(nodeId, m_server);
+		newInstance->setParent(parent);
+		newInstance->setObjectName(browseName);
+		Q_ASSERT(!parent->browseChild(browseName));
+		parent->addChildToIndex(newInstance, browseName);
+		// emit child added to parent
+		emit parent->childAdded(newInstance);
+	}
+	return newInstance;
+}
+
+void QUaServer::addUpdateWrite(UA_WriteValue& writeValue)
+{
+	// NOTE : copy node id, variable could be deleted before commit
+	UA_NodeId nodeId;
+	UA_NodeId_copy(&writeValue.nodeId, &nodeId);
+	writeValue.nodeId = nodeId;
+	// NOTE : takes ownership of value
+	m_updateWrites.append(writeValue);
+	UA_WriteValue_init(&writeValue);
+}
+
+bool QUaServer::iterateEventDriven() const
+{
+	return m_iterEventDriven;
+}
+
+void QUaServer::setIterateEventDriven(const bool& eventDriven)
+{
+	m_iterEventDriven = eventDriven;
+}
+
+void QUaServer::iterateOnEvent()
+{
+	// do not iterate if asked to stop
+	if (!m_running) { return; }
+	m_iterWaitTimer.stop();
+	// write values queued from other threads
+	this->processValueQueue();
+	// non-blocking iteration, only processes sockets with pending data
+	// and due timed callbacks, returns ms until next timed callback
+	UA_UInt16 msNext = UA_Server_run_iterate(m_server, false);
+	// channels might have been opened or closed
+	this->updateSocketNotifiers();
+	// arm timer for next timed callback (publish, sampling, timeouts)
+	m_iterWaitTimer.start(msNext);
+}
+
+void QUaServer::updateSocketNotifiers()
+{
+	// collect current listening and connection sockets
+	QSet<qintptr> setSockets;
+	UA_ServerConfig* config = UA_Server_getConfig(m_server);
+	for (size_t i = 0; i < config->networkLayersSize; ++i)
+	{
+		auto layer = static_cast<ServerNetworkLayerTCP*>(config->networkLayers[i].handle);
+		if (!layer)
 		{
-			retList << node;
+			continue;
 		}
-		UA_NodeId_clear(&retRefSet[i]);
+		for (UA_UInt16 k = 0; k < layer->serverSocketsSize; k++)
+		{
+			setSockets.insert(static_cast<qintptr>(layer->serverSockets[k]));
+		}
+		ConnectionEntry* e;
+		LIST_FOREACH(e, &layer->connections, pointers)
+		{
+			setSockets.insert(static_cast<qintptr>(e->connection.sockfd));
+		}
+	}
+	// remove notifiers of closed sockets
+	auto it = m_iterNotifiers.begin();
+	while (it != m_iterNotifiers.end())
+	{
+		if (setSockets.contains(it.key()))
+		{
+			++it;
+			continue;
+		}
+		// NOTE : socket might be already closed, disable before deleting
+		it.value()->setEnabled(false);
+		delete it.value();
+		it = m_iterNotifiers.erase(it);
+	}
+	// add notifiers for new sockets
+	for (auto socket : setSockets)
+	{
+		if (m_iterNotifiers.contains(socket))
+		{
+			continue;
+		}
+		auto notifier = new QSocketNotifier(socket, QSocketNotifier::Read, this);
+#if QT_VERSION >= 0x050F00
+		QObject::connect(notifier, QOverload<QSocketDescriptor, QSocketNotifier::Type>::of(&QSocketNotifier::activated), this,
+			&QUaServer::iterateOnEvent);
+#else
+		QObject::connect(notifier, &QSocketNotifier::activated, this, 
+			&QUaServer::iterateOnEvent);
+#endif
+		m_iterNotifiers.insert(socket, notifier);
+	}
+}
+
+void QUaServer::clearSocketNotifiers()
+{
+	for (auto notifier : m_iterNotifiers)
+	{
+		notifier->setEnabled(false);
+		delete notifier;
+	}
+	m_iterNotifiers.clear();
+}
+
+bool QUaServer::iterateThreaded() const
+{
+	return m_iterThreaded;
+}
+
+void QUaServer::setIterateThreaded(const bool& threaded)
+{
+	m_iterThreaded = threaded;
+}
+
+void QUaServer::startIterateThread()
+{
+	Q_ASSERT(!m_iterThread);
+	// objects with a parent cannot be moved to another thread
+	Q_ASSERT_X(!this->parent(), "QUaServer::start", "Threaded server cannot have a parent.");
+	if (this->parent())
+	{
+		m_iterThreaded = false;
+		this->start();
+		return;
+	}
+	m_iterThread = new QThread;
+	this->moveServerToThread(m_iterThread);
+	m_iterThread->start();
+	// NOTE : executed in new thread, starts iterating there
+	QMetaObject::invokeMethod(this, [this]() {
+		this->start();
+	}, Qt::QueuedConnection);
+}
+
+void QUaServer::stopIterateThread()
+{
+	Q_ASSERT(m_iterThread);
+	QThread * callerThread = QThread::currentThread();
+	// NOTE : server thread never waits on other threads, so blocking here is safe
+	QMetaObject::invokeMethod(this, [this, callerThread]() {
+		this->stop();
+		this->moveServerToThread(callerThread);
+	}, Qt::BlockingQueuedConnection);
+	m_iterThread->quit();
+	m_iterThread->wait();
+	delete m_iterThread;
+	m_iterThread = nullptr;
+}
+
+void QUaServer::moveServerToThread(QThread * thread)
+{
+	// children (nodes, sessions, signalers) move along, value members do not
+	this->moveToThread(thread);
+	m_iterWaitTimer.moveToThread(thread);
+	m_changeEventTimer.moveToThread(thread);
+	m_changeEventSignaler.moveToThread(thread);
+}
+
+quint16 QUaServer::maxSecureChannels() const
+{
+	return m_maxSecureChannels;
+}
+
+void QUaServer::setMaxSecureChannels(const quint16& maxSecureChannels)
+{
+	m_maxSecureChannels = maxSecureChannels;
+	emit this->maxSecureChannelsChanged(m_maxSecureChannels);
+}
+
+quint16 QUaServer::maxSessions() const
+{
+	return m_maxSessions;
+}
+
+void QUaServer::setMaxSessions(const quint16& maxSessions)
+{
+	m_maxSessions = maxSessions;
+	emit this->maxSessionsChanged(m_maxSessions);
+}
+
+void QUaServer::registerTypeInternal(
+	const QMetaObject& metaObject, 
+	const QUaNodeId& nodeId/* = ""*/
+)
+{
+	// check if OPC UA relevant
+	if (!metaObject.inherits(&QUaNode::staticMetaObject))
+	{
+		Q_ASSERT_X(false, "QUaServer::registerType", "Unsupported base class");
+		return;
+	}
+	// check if already registered
+	QString   strClassName = QString(metaObject.className());
+	UA_NodeId newTypeNodeId = m_mapTypes.value(strClassName, UA_NODEID_NULL);
+	if (!UA_NodeId_isNull(&newTypeNodeId))
+	{
+		Q_ASSERT(m_mapTypes.contains(strClassName));
+		return;
+	}
+	// create new type browse name
+	UA_QualifiedName browseName;
+	browseName.namespaceIndex = 0;
+	browseName.name = QUaTypesConverter::uaStringFromQString(strClassName);
+	// check if base class is registered
+	QString strBaseClassName = QString(metaObject.superClass()->className());
+	if (!m_mapTypes.contains(strBaseClassName))
+	{
+		// recursive
+		this->registerTypeInternal(*metaObject.superClass());
+	}
+	Q_ASSERT_X(m_mapTypes.contains(strBaseClassName), "QUaServer::registerType", "Base object type not registered.");
+	// check if requested node id defined
+	if (!nodeId.isNull())
+	{
+		// check if requested node id exists
+		bool isUsed = this->isNodeIdUsed(nodeId);
+		Q_ASSERT_X(!isUsed, "QUaServer::registerType", "Requested NodeId already exists");
+		if (isUsed)
+		{
+			UA_QualifiedName_clear(&browseName);
+			return;
+		}
+	}
+	UA_NodeId reqNodeId = nodeId;
+	// check if variable or object
+	if (metaObject.inherits(&QUaBaseDataVariable::staticMetaObject))
+	{
+		// create variable type attributes
+		UA_VariableTypeAttributes vtAttr = UA_VariableTypeAttributes_default;
+		// set node attributes		  
+		QByteArray byteDisplayName = strClassName.toUtf8();
+		vtAttr.displayName = UA_LOCALIZEDTEXT((char*)"", byteDisplayName.data());
+		QByteArray byteDescription = QString("").toUtf8();
+		vtAttr.description = UA_LOCALIZEDTEXT((char*)"", byteDescription.data());
+		// add new variable type
+		auto st = UA_Server_addVariableTypeNode(m_server,
+			reqNodeId,                                 // requested nodeId
+			m_mapTypes.value(strBaseClassName, UA_NODEID_NUMERIC(0, UA_NS0ID_BASEDATAVARIABLETYPE)), // parent (variable type)
+			UA_NODEID_NUMERIC(0, UA_NS0ID_HASSUBTYPE), // parent relation with child
+			browseName,
+			UA_NODEID_NULL,                            // typeDefinition ??
+			vtAttr,
+			(void*)this,                               // context : server instance where type was registered
+			&newTypeNodeId);                           // new variable type id
+		Q_ASSERT(st == UA_STATUSCODE_GOOD);
+		Q_UNUSED(st);
+	}
+	else
+	{
+		Q_ASSERT(metaObject.inherits(&QUaBaseObject::staticMetaObject));
+		// create object type attributes
+		UA_ObjectTypeAttributes otAttr = UA_ObjectTypeAttributes_default;
+		// set node attributes		  
+		QByteArray byteDisplayName = strClassName.toUtf8();
+		otAttr.displayName = UA_LOCALIZEDTEXT((char*)"", byteDisplayName.data());
+		QByteArray byteDescription = QString("").toUtf8();
+		otAttr.description = UA_LOCALIZEDTEXT((char*)"", byteDescription.data());
+		// add new object type
+		auto st = UA_Server_addObjectTypeNode(m_server,
+			reqNodeId,                                 // requested nodeId
+			m_mapTypes.value(strBaseClassName, UA_NODEID_NUMERIC(0, UA_NS0ID_BASEOBJECTTYPE)), // parent (object type)
+			UA_NODEID_NUMERIC(0, UA_NS0ID_HASSUBTYPE), // parent relation with child
+			browseName,
+			otAttr,
+			(void*)this,                               // context : server instance where type was registered
+			&newTypeNodeId);                           // new object type id
+		Q_ASSERT(st == UA_STATUSCODE_GOOD);
+		Q_UNUSED(st);
+	}
+	// clean up
+	UA_QualifiedName_clear(&browseName);
+	UA_NodeId_clear(&reqNodeId);
+	// add to registered types map
+	m_mapTypes.insert(strClassName, newTypeNodeId);
+	m_hashMetaObjects.insert(strClassName, metaObject);
+	// register for default mandatory children and so on
+	// in case our custom type inherits from a spec type
+	// which contains mandatory children
+	this->registerTypeDefaults(newTypeNodeId, metaObject);
+	// register constructor/destructor
+	this->registerTypeLifeCycle(newTypeNodeId, metaObject);
+	// register meta-enums
+	this->registerMetaEnums(metaObject);
+	// register meta-properties
+	this->addMetaProperties(metaObject);
+	// register meta-methods (only if object class, or NOT variable class)
+	if (!metaObject.inherits(&QUaBaseDataVariable::staticMetaObject))
+	{
+		this->addMetaMethods(metaObject);
+	}
+}
+
+QList<QUaNode*> QUaServer::typeInstances(const QMetaObject& metaObject)
+{
+	QList<QUaNode*> retList;
+	// check if OPC UA relevant
+	if (!metaObject.inherits(&QUaNode::staticMetaObject))
+	{
+		Q_ASSERT_X(false, "QUaServer::typeInstances", "Unsupported base class. It must derive from QUaNode");
+		return retList;
+	}
+	this->materializeTypeInstances(metaObject);
+	// use index instead of browsing inverse type definition references
+	auto iter = m_hashTypeInstances.find(metaObject.className());
+	if (iter == m_hashTypeInstances.end())
+	{
+		return retList;
+	}
+	retList.reserve(iter.value().count);
+	for (QUaNode* node = iter.value().first; node; node = node->m_typeNext)
+	{
+		retList << node;
 	}
 	return retList;
 }
 
+void QUaServer::addTypeInstance(QUaNode* node, const QMetaObject* metaObject)
+{
+	Q_CHECK_PTR(node);
+	Q_CHECK_PTR(metaObject);
+	Q_ASSERT(!node->m_typeMetaObject);
+	auto& instances = m_hashTypeInstances[metaObject->className()];
+	node->m_typeMetaObject = metaObject;
+	node->m_typePrev = instances.last;
+	node->m_typeNext = nullptr;
+	if (instances.last)
+	{
+		instances.last->m_typeNext = node;
+	}
+	else
+	{
+		instances.first = node;
+	}
+	instances.last = node;
+	instances.count++;
+}
+
+void QUaServer::removeTypeInstance(QUaNode* node)
+{
+	Q_CHECK_PTR(node);
+	if (!node->m_typeMetaObject)
+	{
+		return;
+	}
+	auto iter = m_hashTypeInstances.find(node->m_typeMetaObject->className());
+	Q_ASSERT(iter != m_hashTypeInstances.end());
+	if (iter == m_hashTypeInstances.end())
+	{
+		return;
+	}
+	auto& instances = iter.value();
+	if (node->m_typePrev)
+	{
+		node->m_typePrev->m_typeNext = node->m_typeNext;
+	}
+	else
+	{
+		instances.first = node->m_typeNext;
+	}
+	if (node->m_typeNext)
+	{
+		node->m_typeNext->m_typePrev = node->m_typePrev;
+	}
+	else
+	{
+		instances.last = node->m_typePrev;
+	}
+	instances.count--;
+	node->m_typeMetaObject = nullptr;
+	node->m_typePrev = nullptr;
+	node->m_typeNext = nullptr;
+}
+
 void QUaServer::registerEnum(const QMetaEnum& metaEnum, const QUaNodeId& nodeId/* = ""*/)
 {
 	// compose enum name
@@ -1884,6 +2770,59 @@ void QUaServer::registerTypeLifeCycle(const UA_NodeId& typeNodeId, const QMetaOb
 	Q_UNUSED(st)
 }
 
+const QVector<QUaQualifiedName>& QUaServer::typeLayout(const QMetaObject& metaObject, const UA_NodeId& nodeId)
+{
+	auto it = m_hashTypeLayouts.find(&metaObject);
+	if (it != m_hashTypeLayouts.end())
+	{
+		return it.value();
+	}
+	QVector<QUaQualifiedName> layout;
+	QSet<QUaQualifiedName>    setNames;
+	// list meta props
+	int propCount  = metaObject.propertyCount();
+	int propOffset = QUaNode::getPropsOffsetHelper(metaObject);
+	for (int i = propOffset; i < propCount; i++)
+	{
+		QMetaProperty metaProperty = metaObject.property(i);
+		// check if not enum
+		if (!metaProperty.isEnumType())
+		{
+			// check if available in meta-system
+			if (!QMetaType::metaObjectForType(metaProperty.userType()))
+			{ continue; }
+			// check if OPC UA relevant type
+			const QMetaObject propMetaObject = *QMetaType::metaObjectForType(metaProperty.userType());
+			if (!propMetaObject.inherits(&QUaNode::staticMetaObject))
+			{ continue; }
+			// check if prop inherits from parent
+			Q_ASSERT_X(!propMetaObject.inherits(&metaObject), "QUaServer::typeLayout", 
+				"Qt MetaProperty type cannot inherit from Class.");
+			if (propMetaObject.inherits(&metaObject))
+			{ continue; }
+		}
+		// the Qt meta property name must match the UA browse name
+		QUaQualifiedName browseName(QString(metaProperty.name()));
+		layout << browseName;
+		setNames << browseName;
+	}
+	// mandatory children of instance declarations
+	UA_NodeId uaTypeNodeId = QUaNode::typeDefinitionNodeId(nodeId, m_server);
+	QUaNodeId typeNodeId = uaTypeNodeId;
+	UA_NodeId_clear(&uaTypeNodeId);
+	Q_ASSERT(m_hashMandatoryChildren.contains(typeNodeId));
+	const auto &mandatoryList = m_hashMandatoryChildren[typeNodeId];
+	for (const auto &browseName : mandatoryList)
+	{
+		if (setNames.contains(browseName))
+		{
+			continue;
+		}
+		layout << browseName;
+	}
+	return m_hashTypeLayouts.insert(&metaObject, layout).value();
+}
+
 void QUaServer::registerTypeDefaults(const UA_NodeId& typeNodeId, const QMetaObject& metaObject)
 {
 	// cache mandatory children if not done before
@@ -2315,19 +3254,143 @@ void QUaServer::addMetaMethods(const QMetaObject& parentMetaObject)
 			return QUaServer::callMetaMethod(this, object, metaMethod, input, output);
 		};
 	}
-}
-
-// NOTE : do not clean
-UA_NodeId QUaServer::typeIdByMetaObject(const QMetaObject& metaObject)
-{
-	QString   strClassName = QString(metaObject.className());
-	UA_NodeId typeNodeId   = m_mapTypes.value(strClassName, UA_NODEID_NULL);
-	if (UA_NodeId_isNull(&typeNodeId))
+}
+
+// NOTE : do not clean
+UA_NodeId QUaServer::typeIdByMetaObject(const QMetaObject& metaObject)
+{
+	QString   strClassName = QString(metaObject.className());
+	UA_NodeId typeNodeId   = m_mapTypes.value(strClassName, UA_NODEID_NULL);
+	if (UA_NodeId_isNull(&typeNodeId))
+	{
+		this->registerTypeInternal(metaObject);
+		typeNodeId = m_mapTypes.value(strClassName, UA_NODEID_NULL);
+	}
+	return typeNodeId;
+}
+
+bool QUaServer::isInstantiableType(const QMetaObject& metaObject) const
+{
+	// check if OPC UA relevant
+	if (!metaObject.inherits(&QUaNode::staticMetaObject))
+	{
+		Q_ASSERT_X(false, "QUaServer::createInstance",
+			"Unsupported base class. It must derive from QUaNode");
+		return false;
+	}
+#ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
+	// check if inherits BaseEventType, in which case this method cannot be used
+	if (metaObject.inherits(&QUaBaseEvent::staticMetaObject) 
+#ifdef UA_ENABLE_SUBSCRIPTIONS_ALARMS_CONDITIONS
+		&& !metaObject.inherits(&QUaCondition::staticMetaObject)
+#endif // UA_ENABLE_SUBSCRIPTIONS_ALARMS_CONDITIONS
+		)
+	{
+		Q_ASSERT_X(false, "QUaServer::createInstance",
+			"Cannot use createInstance to create Non-Condition Events. Use createEvent method instead");
+		return false;
+	}
+#endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
+	// NOTE : a type is considered to inherit itself 
+	// (http://doc.qt.io/qt-5/qmetaobject.html#inherits)
+	Q_ASSERT(metaObject.inherits(&QUaBaseVariable::staticMetaObject) ||
+		metaObject.inherits(&QUaBaseObject::staticMetaObject) ||
+		metaObject.className() == QUaBaseObject::staticMetaObject.className());
+	return true;
+}
+
+// NOTE : need to cleanup result with UA_VariableAttributes_clear
+UA_VariableAttributes QUaServer::typeVariableAttributes(const UA_NodeId& typeNodeId) const
+{
+	// some types require the attrs to match because open62541 checks them
+	UA_VariableAttributes vAttr = UA_VariableAttributes_default;
+	auto st = UA_Server_readDataType(m_server, typeNodeId, &vAttr.dataType);
+	Q_ASSERT(st == UA_STATUSCODE_GOOD);
+	Q_UNUSED(st);
+	st = UA_Server_readValueRank(m_server, typeNodeId, &vAttr.valueRank);
+	Q_ASSERT(st == UA_STATUSCODE_GOOD);
+	Q_UNUSED(st);
+	UA_Variant outArrayDimensions;
+	st = UA_Server_readArrayDimensions(m_server, typeNodeId, &outArrayDimensions);
+	Q_ASSERT(st == UA_STATUSCODE_GOOD);
+	Q_UNUSED(st);
+	// take ownership of array
+	vAttr.arrayDimensionsSize = outArrayDimensions.arrayLength;
+	vAttr.arrayDimensions = static_cast<quint32*>(outArrayDimensions.data);
+	return vAttr;
+}
+
+UA_NodeId QUaServer::addInstanceNode(
+	const QMetaObject           &metaObject,
+	QUaNode                     *parentNode,
+	const UA_NodeId             &referenceTypeId,
+	const UA_NodeId             &typeNodeId,
+	const UA_VariableAttributes *typeAttr,
+	const QUaQualifiedName      &browseName,
+	const UA_NodeId             &reqNodeId
+)
+{
+	Q_ASSERT(parentNode ? !UA_NodeId_isNull(&parentNode->m_nodeId) : true);
+	UA_QualifiedName uaBrowseName = browseName;
+	// default displayName is browseName
+	QByteArray byteDisplayName = browseName.name().toUtf8();
+	// NOTE : calling UA_Server_addXXX below will trigger QUaServer::uaConstructor
+	// which will instantiate the respective Qt instance and binding
+	UA_NodeId nodeIdNewInstance = UA_NODEID_NULL;
+	UA_StatusCode st;
+	// check if variable or object 
+	if (typeAttr)
+	{
+		// shallow copy, type attributes are shared by all instances
+		UA_VariableAttributes vAttr = *typeAttr;
+		vAttr.displayName = UA_LOCALIZEDTEXT((char*)"", byteDisplayName.data());
+		// add variable
+		st = UA_Server_addVariableNode(m_server,
+			reqNodeId,            // requested nodeId
+			parentNode ? parentNode->m_nodeId : UA_NODEID_NULL, // parent (can be null)
+			referenceTypeId,      // parent relation with child
+			uaBrowseName,
+			typeNodeId,
+			vAttr,
+			nullptr,             // context
+			&nodeIdNewInstance); // set new nodeId to new instance
+	}
+	else
 	{
-		this->registerTypeInternal(metaObject);
-		typeNodeId = m_mapTypes.value(strClassName, UA_NODEID_NULL);
+		UA_ObjectAttributes oAttr = UA_ObjectAttributes_default;
+		oAttr.displayName = UA_LOCALIZEDTEXT((char*)"", byteDisplayName.data());
+		// add object
+		st = UA_Server_addObjectNode(m_server,
+			reqNodeId,            // requested nodeId
+			parentNode ? parentNode->m_nodeId : UA_NODEID_NULL, // parent
+			referenceTypeId,      // parent relation with child
+			uaBrowseName,
+			typeNodeId,
+			oAttr,
+			nullptr,             // context
+			&nodeIdNewInstance); // set new nodeId to new instance
 	}
-	return typeNodeId;
+	Q_ASSERT(st == UA_STATUSCODE_GOOD);
+	UA_QualifiedName_clear(&uaBrowseName);
+	if (st != UA_STATUSCODE_GOOD)
+	{
+		return UA_NODEID_NULL;
+	}
+	// if child is condition, add non-hierarchical reference and default props
+#ifdef UA_ENABLE_SUBSCRIPTIONS_ALARMS_CONDITIONS
+	if (parentNode && metaObject.inherits(&QUaCondition::staticMetaObject))
+	{
+		// add HasCondition reference
+		auto node = QUaNode::getNodeContext(nodeIdNewInstance, this->m_server);
+		auto condition = qobject_cast<QUaCondition*>(node);
+		Q_CHECK_PTR(condition);
+		// set default originator
+		condition->QUaBaseEvent::setSourceNode(parentNode);
+	}
+#else
+	Q_UNUSED(metaObject);
+#endif // UA_ENABLE_SUBSCRIPTIONS_ALARMS_CONDITIONS
+	return nodeIdNewInstance;
 }
 
 UA_NodeId QUaServer::createInstanceInternal(
@@ -2337,41 +3400,19 @@ UA_NodeId QUaServer::createInstanceInternal(
 	const QUaNodeId& nodeId
 )
 {
-	// check if OPC UA relevant
-	if (!metaObject.inherits(&QUaNode::staticMetaObject))
-	{
-		Q_ASSERT_X(false, "QUaServer::createInstance",
-			"Unsupported base class. It must derive from QUaNode");
-		return UA_NODEID_NULL;
-	}
-#ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
-	// check if inherits BaseEventType, in which case this method cannot be used
-	if (metaObject.inherits(&QUaBaseEvent::staticMetaObject) 
-#ifdef UA_ENABLE_SUBSCRIPTIONS_ALARMS_CONDITIONS
-		&& !metaObject.inherits(&QUaCondition::staticMetaObject)
-#endif // UA_ENABLE_SUBSCRIPTIONS_ALARMS_CONDITIONS
-		)
+	if (!this->isInstantiableType(metaObject))
 	{
-		Q_ASSERT_X(false, "QUaServer::createInstanceInternal",
-			"Cannot use createInstance to create Non-Condition Events. Use createEvent method instead");
 		return UA_NODEID_NULL;
 	}
-#endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
 	// try to get typeNodeId, if null, then register it
 	UA_NodeId typeNodeId = this->typeIdByMetaObject(metaObject);
 	Q_ASSERT(!UA_NodeId_isNull(&typeNodeId));
-	// adapt parent relation with child according to parent type
-	// NOTE : parent can be null (no address space representation, e.g. events, conditions)
-	UA_NodeId referenceTypeId = parentNode ?
-		QUaServer::getReferenceTypeId(*parentNode->metaObject(), metaObject) :
-		UA_NODEID_NULL;
 	// check if browse name already used with parent (if any parent)
 	if (parentNode && parentNode->hasChild(browseName))
 	{
 		Q_ASSERT_X(false, "QUaServer::createInstance", "Requested BrowseName already exists in parent");
 		return UA_NODEID_NULL;
 	}
-	UA_QualifiedName uaBrowseName = browseName;
 	// check if requested node id defined
 	if (!nodeId.isNull())
 	{
@@ -2383,87 +3424,30 @@ UA_NodeId QUaServer::createInstanceInternal(
 			return UA_NODEID_NULL;
 		}
 	}
-	// NOTE : calling UA_Server_addXXX below will trigger QUaServer::uaConstructor
-	// which will instantiate the respective Qt instance and binding
+	// adapt parent relation with child according to parent type
+	// NOTE : parent can be null (no address space representation, e.g. events, conditions)
+	UA_NodeId referenceTypeId = parentNode ?
+		QUaServer::getReferenceTypeId(*parentNode->metaObject(), metaObject) :
+		UA_NODEID_NULL;
 	UA_NodeId reqNodeId = nodeId;
 	UA_NodeId nodeIdNewInstance;
-	// check if variable or object 
-	// NOTE : a type is considered to inherit itself 
-	// (http://doc.qt.io/qt-5/qmetaobject.html#inherits)
-	Q_ASSERT(parentNode ? !UA_NodeId_isNull(&parentNode->m_nodeId) : true);
 	if (metaObject.inherits(&QUaBaseVariable::staticMetaObject))
 	{
-		// some types require the attrs to match because open62541 checks them
-		UA_VariableAttributes vAttr = UA_VariableAttributes_default;
-		auto st = UA_Server_readDataType(m_server, typeNodeId, &vAttr.dataType);
-		Q_ASSERT(st == UA_STATUSCODE_GOOD);
-		Q_UNUSED(st);
-		st = UA_Server_readValueRank(m_server, typeNodeId, &vAttr.valueRank);
-		Q_ASSERT(st == UA_STATUSCODE_GOOD);
-		Q_UNUSED(st);
-		UA_Variant outArrayDimensions;
-		st = UA_Server_readArrayDimensions(m_server, typeNodeId, &outArrayDimensions);
-		Q_ASSERT(st == UA_STATUSCODE_GOOD);
-		Q_UNUSED(st);
-		vAttr.arrayDimensionsSize = outArrayDimensions.arrayLength;
-		vAttr.arrayDimensions = static_cast<quint32*>(outArrayDimensions.data);
-		// default displayName is browseName
-		QByteArray byteDisplayName = browseName.name().toUtf8();
-		vAttr.displayName = UA_LOCALIZEDTEXT((char*)"", byteDisplayName.data());
-		// add variable
-		UA_Server_addVariableNode(m_server,
-			reqNodeId,            // requested nodeId
-			parentNode ? parentNode->m_nodeId : UA_NODEID_NULL, // parent (can be null)
-			referenceTypeId,      // parent relation with child
-			uaBrowseName,
-			typeNodeId,
-			vAttr,
-			nullptr,             // context
-			&nodeIdNewInstance); // set new nodeId to new instance
-		Q_ASSERT(st == UA_STATUSCODE_GOOD);
-		Q_UNUSED(st);
-		UA_Variant_clear(&outArrayDimensions);
+		UA_VariableAttributes vAttr = this->typeVariableAttributes(typeNodeId);
+		nodeIdNewInstance = this->addInstanceNode(metaObject, parentNode, 
+			referenceTypeId, typeNodeId, &vAttr, browseName, reqNodeId);
+		UA_VariableAttributes_clear(&vAttr);
 	}
 	else
 	{
-		Q_ASSERT(metaObject.inherits(&QUaBaseObject::staticMetaObject) ||
-			metaObject.className() == QUaBaseObject::staticMetaObject.className());
-		UA_ObjectAttributes oAttr = UA_ObjectAttributes_default;
-		// default displayName is browseName
-		QByteArray byteDisplayName = browseName.name().toUtf8();
-		oAttr.displayName = UA_LOCALIZEDTEXT((char*)"", byteDisplayName.data());
-		// add object
-		auto st = UA_Server_addObjectNode(m_server,
-			reqNodeId,            // requested nodeId
-			parentNode ? parentNode->m_nodeId : UA_NODEID_NULL, // parent
-			referenceTypeId,      // parent relation with child
-			uaBrowseName,
-			typeNodeId,
-			oAttr,
-			nullptr,             // context
-			&nodeIdNewInstance); // set new nodeId to new instance
-		Q_ASSERT(st == UA_STATUSCODE_GOOD);
-		Q_UNUSED(st);
+		nodeIdNewInstance = this->addInstanceNode(metaObject, parentNode, 
+			referenceTypeId, typeNodeId, nullptr, browseName, reqNodeId);
 	}
 	Q_ASSERT_X(!UA_NodeId_isNull(&nodeIdNewInstance), "QUaServer::createInstanceInternal", "Something went wrong");
 	// clean up
 	UA_NodeId_clear(&reqNodeId);
 	// NOTE : do not UA_NodeId_clear(&typeNodeId); or value in m_mapTypes gets corrupted
 	UA_NodeId_clear(&referenceTypeId);
-	UA_QualifiedName_clear(&uaBrowseName);
-
-	// if child is condition, add non-hierarchical reference and default props
-#ifdef UA_ENABLE_SUBSCRIPTIONS_ALARMS_CONDITIONS
-	if (parentNode && metaObject.inherits(&QUaCondition::staticMetaObject))
-	{
-		// add HasCondition reference
-		auto node = QUaNode::getNodeContext(nodeIdNewInstance, this->m_server);
-		auto condition = qobject_cast<QUaCondition*>(node);
-		Q_CHECK_PTR(condition);
-		// set default originator
-		condition->QUaBaseEvent::setSourceNode(parentNode);
-	}
-#endif // UA_ENABLE_SUBSCRIPTIONS_ALARMS_CONDITIONS
 
 	// trigger reference added, model change event, so client (UaExpert) auto refreshes tree
 #ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
@@ -2483,6 +3467,72 @@ UA_NodeId QUaServer::createInstanceInternal(
 	return nodeIdNewInstance;
 }
 
+QList<UA_NodeId> QUaServer::createInstancesInternal(
+	const QMetaObject& metaObject,
+	QUaNode* parentNode,
+	const int& count,
+	const std::function<QUaQualifiedName(const int&)>& nameGenerator
+)
+{
+	QList<UA_NodeId> retList;
+	if (count <= 0 || !nameGenerator || !this->isInstantiableType(metaObject))
+	{
+		return retList;
+	}
+	// resolve type, parent relation and type attributes once for the whole batch
+	UA_NodeId typeNodeId = this->typeIdByMetaObject(metaObject);
+	Q_ASSERT(!UA_NodeId_isNull(&typeNodeId));
+	UA_NodeId referenceTypeId = parentNode ?
+		QUaServer::getReferenceTypeId(*parentNode->metaObject(), metaObject) :
+		UA_NODEID_NULL;
+	bool isVariable = metaObject.inherits(&QUaBaseVariable::staticMetaObject);
+	UA_VariableAttributes vAttr = isVariable ? 
+		this->typeVariableAttributes(typeNodeId) : UA_VariableAttributes_default;
+	// NOTE : new node ids are assigned by the nodestore, so no existence checks needed;
+	//        only browse names need to be unique within the batch and the parent
+	QSet<QUaQualifiedName> setBrowseNames;
+	setBrowseNames.reserve(count);
+	retList.reserve(count);
+	for (int i = 0; i < count; i++)
+	{
+		QUaQualifiedName browseName = nameGenerator(i);
+		if (setBrowseNames.contains(browseName) ||
+			(parentNode && parentNode->hasChild(browseName)))
+		{
+			Q_ASSERT_X(false, "QUaServer::createInstances", "Requested BrowseName already exists in parent");
+			continue;
+		}
+		setBrowseNames << browseName;
+		UA_NodeId nodeIdNewInstance = this->addInstanceNode(metaObject, parentNode, 
+			referenceTypeId, typeNodeId, isVariable ? &vAttr : nullptr, browseName, UA_NODEID_NULL);
+		if (UA_NodeId_isNull(&nodeIdNewInstance))
+		{
+			continue;
+		}
+		retList << nodeIdNewInstance;
+	}
+	// clean up
+	// NOTE : do not UA_NodeId_clear(&typeNodeId); or value in m_mapTypes gets corrupted
+	if (isVariable)
+	{
+		UA_VariableAttributes_clear(&vAttr);
+	}
+	UA_NodeId_clear(&referenceTypeId);
+	// single reference added, model change event for the whole batch
+#ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
+	if (!retList.isEmpty() && parentNode && parentNode->inAddressSpace())
+	{
+		Q_CHECK_PTR(m_changeEvent);
+		this->addChange({
+			parentNode->nodeId(),
+			parentNode->typeDefinitionNodeId(),
+			QUaChangeVerb::ReferenceAdded
+		});
+	}
+#endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
+	return retList;
+}
+
 #ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
 
 UA_NodeId QUaServer::createEventInternal(
@@ -2518,6 +3568,7 @@ void QUaServer::bindCppInstanceWithUaNode(QUaNode* nodeInstance, UA_NodeId& node
 	UA_Server_setNodeContext(m_server, nodeId, (void**)(&nodeInstance));
 	// set node id to c++ instance
 	nodeInstance->m_nodeId = nodeId;
+	m_hashNodes[nodeId] = nodeInstance;
 }
 
 bool QUaServer::isMetaObjectRegistered(const QString& strClassName) const
@@ -2836,12 +3887,103 @@ QUaFolderObject* QUaServer::objectsFolder() const
 
 QUaNode* QUaServer::nodeById(const QUaNodeId& nodeIdIn)
 {
+	QUaNode* node = m_hashNodes.value(nodeIdIn, nullptr);
+	if (node || !m_lazyInstantiation || nodeIdIn.isNull())
+	{
+		return node;
+	}
+	// try to instantiate, parent first (recursive)
 	UA_NodeId nodeId = nodeIdIn;
-	QUaNode* node = QUaNode::getNodeContext(nodeId, m_server);
+	UA_NodeId parentNodeId = QUaNode::getParentNodeId(nodeId, m_server);
+	QUaNode* parent = UA_NodeId_isNull(&parentNodeId) ? nullptr : this->nodeById(parentNodeId);
+	UA_NodeId_clear(&parentNodeId);
+	if (parent)
+	{
+		// NOTE : instantiating the parent might have instantiated the node
+		node = m_hashNodes.value(nodeIdIn, nullptr);
+		if (!node)
+		{
+			node = parent->materializeChild(nodeId, QUaNode::getBrowseName(nodeId, m_server));
+		}
+	}
 	UA_NodeId_clear(&nodeId);
 	return node;
 }
 
+bool QUaServer::lazyInstantiation() const
+{
+	return m_lazyInstantiation;
+}
+
+void QUaServer::setLazyInstantiation(const bool& lazy)
+{
+	m_lazyInstantiation = lazy;
+}
+
+void QUaServer::materializeTypeInstances(const QMetaObject& metaObject)
+{
+	if (!m_lazyInstantiation)
+	{
+		return;
+	}
+	UA_NodeId typeNodeId = m_mapTypes.value(QString(metaObject.className()), UA_NODEID_NULL);
+	if (UA_NodeId_isNull(&typeNodeId))
+	{
+		return;
+	}
+	// browse instances through inverse type definition references
+	UA_BrowseDescription* bDesc = UA_BrowseDescription_new();
+	UA_NodeId_copy(&typeNodeId, &bDesc->nodeId);
+	bDesc->referenceTypeId = UA_NODEID_NUMERIC(0, UA_NS0ID_HASTYPEDEFINITION);
+	bDesc->browseDirection = UA_BROWSEDIRECTION_INVERSE;
+	bDesc->includeSubtypes = false;
+	bDesc->nodeClassMask   = UA_NODECLASS_OBJECT | UA_NODECLASS_VARIABLE;
+	bDesc->resultMask      = UA_BROWSERESULTMASK_NONE;
+	UA_BrowseResult bRes = UA_Server_browse(m_server, 0, bDesc);
+	Q_ASSERT(bRes.statusCode == UA_STATUSCODE_GOOD);
+	// NOTE : collect first, instantiating adds references to the type
+	QList<UA_NodeId> instancesNodeIds;
+	while (bRes.referencesSize > 0)
+	{
+		for (size_t i = 0; i < bRes.referencesSize; i++)
+		{
+			const UA_NodeId& instanceNodeId = bRes.references[i].nodeId.nodeId;
+			if (m_hashNodes.contains(instanceNodeId) || m_liteHandles.contains(instanceNodeId))
+			{
+				continue;
+			}
+			UA_NodeId nodeId;
+			UA_NodeId_copy(&instanceNodeId, &nodeId);
+			instancesNodeIds << nodeId;
+		}
+		UA_BrowseResult_deleteMembers(&bRes);
+		bRes = UA_Server_browseNext(m_server, true, &bRes.continuationPoint);
+	}
+	UA_BrowseResult_deleteMembers(&bRes);
+	UA_BrowseDescription_deleteMembers(bDesc);
+	UA_BrowseDescription_delete(bDesc);
+	// NOTE : instance declarations of other types have no bound parent and are ignored
+	for (auto& nodeId : instancesNodeIds)
+	{
+		this->nodeById(nodeId);
+		UA_NodeId_clear(&nodeId);
+	}
+}
+
+const QMetaObject* QUaServer::metaObjectByTypeId(const UA_NodeId& typeNodeId)
+{
+	for (auto it = m_mapTypes.cbegin(); it != m_mapTypes.cend(); ++it)
+	{
+		if (!UA_NodeId_equal(&it.value(), &typeNodeId))
+		{
+			continue;
+		}
+		auto metaObject = m_hashMetaObjects.find(it.key());
+		return metaObject != m_hashMetaObjects.end() ? &metaObject.value() : nullptr;
+	}
+	return nullptr;
+}
+
 bool QUaServer::isTypeNameRegistered(const QString& strTypeName) const
 {
 	return m_mapTypes.contains(strTypeName);
@@ -2853,23 +3995,119 @@ QUaNode * QUaServer::browsePath(const QUaBrowsePath& browsePath) const
 	{
 		return nullptr;
 	}
-	QUaQualifiedName first = browsePath.first();
-	// check if first is ObjectsFolder
-	if (first == this->objectsFolder()->browseName())
+	// one child index lookup per element (see QUaNode::browseChild)
+	QUaNode* currNode = this->browsePathRoot(browsePath.first());
+	for (int i = 1; currNode && i < browsePath.count(); i++)
+	{
+		currNode = currNode->browseChild(browsePath.at(i));
+	}
+	return currNode;
+}
+
+QUaNode * QUaServer::browsePath(const QString& strPath, const QString& separator/* = "/"*/) const
+{
+	return this->browsePath(QUaServer::browsePathFromString(strPath, separator));
+}
+
+QList<QUaNode*> QUaServer::browsePaths(const QList<QUaBrowsePath>& browsePaths) const
+{
+	QList<QUaNode*> retList;
+	retList.reserve(browsePaths.count());
+	// nodes resolved for previous path, reused for common prefix
+	QVector<QUaNode*> prevNodes;
+	QUaBrowsePath     prevPath;
+	for (const auto& browsePath : browsePaths)
+	{
+		int common = 0;
+		int maxCommon = (std::min)(browsePath.count(), prevNodes.count());
+		while (common < maxCommon && browsePath.at(common) == prevPath.at(common))
+		{
+			common++;
+		}
+		prevNodes.resize(common);
+		for (int i = common; i < browsePath.count(); i++)
+		{
+			QUaNode* currNode = i == 0 ?
+				this->browsePathRoot(browsePath.first()) :
+				prevNodes.last()->browseChild(browsePath.at(i));
+			if (!currNode)
+			{
+				break;
+			}
+			prevNodes << currNode;
+		}
+		bool found = browsePath.count() > 0 && prevNodes.count() == browsePath.count();
+		retList << (found ? prevNodes.last() : nullptr);
+		prevPath = browsePath;
+	}
+	return retList;
+}
+
+QList<QUaNode*> QUaServer::browsePaths(const QStringList& strPaths, const QString& separator/* = "/"*/) const
+{
+	QList<QUaBrowsePath> browsePaths;
+	browsePaths.reserve(strPaths.count());
+	for (const auto& strPath : strPaths)
+	{
+		browsePaths << QUaServer::browsePathFromString(strPath, separator);
+	}
+	return this->browsePaths(browsePaths);
+}
+
+QUaQualifiedName QUaServer::internBrowseName(const QUaQualifiedName& browseName)
+{
+	QString name = browseName.name();
+	if (name.isEmpty())
+	{
+		return browseName;
+	}
+	auto iter = m_internedNames.constFind(name);
+	if (iter != m_internedNames.constEnd())
 	{
-		return this->objectsFolder()->browsePath(browsePath.mid(1));
+		return QUaQualifiedName(browseName.namespaceIndex(), *iter);
 	}
-	// then check if first is a child of ObjectsFolder
-	auto listChildren = this->objectsFolder()->browseChildren();
-	for (auto child : listChildren)
+	// drop names only referenced by the table before growing it
+	if (m_internedNames.count() >= m_internedPrune)
 	{
-		if (first == child->browseName())
+		auto it = m_internedNames.begin();
+		while (it != m_internedNames.end())
 		{
-			return child->browsePath(browsePath.mid(1));
+			if (it->isDetached())
+			{
+				it = m_internedNames.erase(it);
+				continue;
+			}
+			++it;
 		}
+		m_internedPrune = (std::max)(QUA_INTERN_PRUNE_MIN, m_internedNames.count() * 2);
 	}
-	// if not, then not supported
-	return nullptr;
+	m_internedNames.insert(name);
+	return QUaQualifiedName(browseName.namespaceIndex(), name);
+}
+
+QUaBrowsePath QUaServer::browsePathFromString(const QString& strPath, const QString& separator)
+{
+	// NOTE : unlike QUaQualifiedName::expandName, keep namespace of each element
+	QUaBrowsePath retPath;
+	auto parts = QStringRef(&strPath).split(separator);
+	retPath.reserve(parts.count());
+	for (const auto& part : parts)
+	{
+		retPath << QUaQualifiedName(part.toString());
+	}
+	return retPath;
+}
+
+QUaNode* QUaServer::browsePathRoot(const QUaQualifiedName& first) const
+{
+	// check if first is ObjectsFolder
+	QUaNode* objectsFolder = this->objectsFolder();
+	if (first == objectsFolder->browseName())
+	{
+		return objectsFolder;
+	}
+	// then check if first is a child of ObjectsFolder, if not, then not supported
+	return objectsFolder->browseChild(first);
 }
 
 #ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
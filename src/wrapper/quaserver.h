@@ -4,6 +4,10 @@
 #include <type_traits>
 
 #include <QTimer>
+#include <QElapsedTimer>
+#include <QSocketNotifier>
+#include <QMutex>
+#include <QThread>
 
 #include <QUaTypesConverter>
 #include <QUaFolderObject>
@@ -110,6 +114,15 @@ public:
 	void stop();
 	bool isRunning() const;
 	void setIsRunning(const bool &running); // same as start/stop, just to complete Qt property
+	// if true, iterate only when sockets have data or a timed callback is due
+	// instead of continuously polling (default false)
+	bool iterateEventDriven() const;
+	void setIterateEventDriven(const bool &eventDriven); // NOTE : only updates after server restart
+	// if true, start() moves the server to a dedicated thread and iterates there (default false)
+	// NOTE : server cannot have a parent, while running it and its nodes must only be accessed
+	//        from its thread (QMetaObject::invokeMethod, queued signals or queueValue)
+	bool iterateThreaded() const;
+	void setIterateThreaded(const bool &threaded); // NOTE : only updates after server restart
 
 	// Server Limits API
 
@@ -127,6 +140,9 @@ public:
 	// get all instances of a type
 	template<typename T>
 	QList<T*> typeInstances();
+	// iterate all instances of a type without allocating a list
+	template<typename T, typename M>
+	void forEachTypeInstance(const M &callback);
 	// subscribe to instance of a type added
 	template<typename T, typename M>
 	QMetaObject::Connection instanceCreated(const M &callback);
@@ -163,6 +179,14 @@ public:
         QUaNode * parentNode, 
         const QUaQualifiedName &browseName,
         const QUaNodeId &nodeId = ""
+    );
+	// create many instances of a given (variable or object) type under the same parent,
+	// browse names are generated by calling nameGenerator with the index of each instance
+	template<typename T>
+	QList<T*> createInstances(
+        QUaNode * parentNode, 
+        const int &count,
+        const std::function<QUaQualifiedName(const int&)> &nameGenerator
     );
 	// get objects folder
 	QUaFolderObject * objectsFolder() const;
@@ -174,6 +198,92 @@ public:
 	// check if a type with type name (C++ class name) is registered
 	bool isTypeNameRegistered(const QString &strTypeName) const;
 
+	// Value Ingestion API
+
+	// queue a new value for a variable, can be called from any thread
+	// queued values are written in the server thread as a single batch before the next iteration
+	// NOTE : variable is identified by its node id, which must be read in advance from the server
+	//        thread (QUaNode::nodeId), values for deleted variables are discarded
+	template<typename T>
+	void queueValue(
+		const QUaNodeId     &nodeId,
+		const T             &value,
+		const QUaStatusCode &statusCode      = QUaStatus::Good,
+		const QDateTime     &sourceTimestamp = QDateTime()
+	);
+
+	// Batch Update API
+
+	// values set with QUaBaseVariable::setValue after beginUpdate are not written immediately,
+	// they are collected and written in a single pass when calling commitUpdate
+	// NOTE : until then, getters return the last committed values; calls can be nested
+	void beginUpdate();
+	void commitUpdate();
+	bool isUpdating() const;
+
+	// Polling Scheduler API
+
+	// polled variables are grouped by interval, on each tick the provider is called once per group
+	// with all the variables of the group and must return their new values in the same order
+	// (invalid QVariant to skip a variable), the values are written in a single batch update
+	void setPollProvider(const std::function<QVariantList(const QVector<QUaBaseVariable*>&)>& provider);
+	// interval in ms, if not positive the minimumSamplingInterval of the variable is used
+	// (or 1000 ms if not set); adding an already polled variable updates its interval
+	void addPolledVariable(QUaBaseVariable* variable, const int& interval = -1);
+	void removePolledVariable(QUaBaseVariable* variable);
+
+	// Lite Variables API
+
+	// lite variables only live in the nodestore (no C++ instance) and are addressed by a handle,
+	// meant for huge tag counts; returns -1 on error
+	// NOTE : not indexed as children of the parent node, so not found by QUaNode::browseChild
+	int  addLiteVariable(
+		QUaNode                *parentNode,
+		const QUaQualifiedName &browseName,
+		const QVariant         &value  = QVariant(),
+		const QUaNodeId        &nodeId = ""
+	);
+	void removeLiteVariable(const int& handle);
+	bool isLiteVariable(const int& handle) const;
+	QUaNodeId liteVariableNodeId(const int& handle) const;
+	// new values must have the same type as the initial value
+	QVariant liteValue(const int& handle) const;
+	template<typename T>
+	T    liteValue(const int& handle) const;
+	bool setLiteValue(const int& handle, const QVariant& value);
+	template<typename T>
+	bool setLiteValue(const int& handle, const T& value);
+	// called when a client writes the value, also makes the variable writable (nullptr to remove)
+	void setLiteValueChangedCallback(
+		const int& handle, 
+		const std::function<void(const int&, const QVariant&)>& callback
+	);
+	// create the C++ instance on demand, after this the handle is released
+	QUaBaseDataVariable* materializeLiteVariable(const int& handle);
+
+	// Lazy Instantiation API
+
+	// if enabled, only nodes created directly under a bound parent get a C++ instance,
+	// their children only exist in the nodestore until accessed through browseChild,
+	// browseChildren, browsePath or nodeById (or if an instanceCreated callback exists for the type)
+	// NOTE : typeInstances, forEachTypeInstance and monitoring a value also instantiate them,
+	//        so the first call for a type browses the nodestore; lite variables are never instantiated
+	bool lazyInstantiation() const;
+	void setLazyInstantiation(const bool& lazy);
+
+#ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
+	// Model Change Events API
+
+	// minimum time in ms between GeneralModelChangeEvents, changes in between are buffered
+	// (default 0, sent on next event loop iteration)
+	int  modelChangeMinInterval() const;
+	void setModelChangeMinInterval(const int& interval);
+	// max changes per event, if exceeded a single change on the ObjectsFolder is sent instead
+	// so clients refresh the whole tree (default 0, unlimited)
+	int  modelChangeMaxCount() const;
+	void setModelChangeMaxCount(const int& maxCount);
+#endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
+
 	// Browse API
 	// (* actually browses using QObject tree)
 
@@ -181,6 +291,13 @@ public:
 	T* browsePath(const QUaBrowsePath& browsePath) const;
 	// specialization
 	QUaNode * browsePath(const QUaBrowsePath& browsePath) const;
+	// path as string, e.g. "Objects/ns=1;s=Plant/Area/Tag", each element is parsed
+	// as a QUaQualifiedName (elements without namespace prefix default to ns=0)
+	QUaNode * browsePath(const QString& strPath, const QString& separator = "/") const;
+	// resolve many paths at once, nullptr for paths not found
+	// NOTE : common prefixes of consecutive paths are resolved once, so better sorted
+	QList<QUaNode*> browsePaths(const QList<QUaBrowsePath>& browsePaths) const;
+	QList<QUaNode*> browsePaths(const QStringList& strPaths, const QString& separator = "/") const;
 
 #ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
 	// Events API
@@ -269,6 +386,8 @@ signals:
 
 public slots:
 	
+protected:
+	void timerEvent(QTimerEvent* event) override;
 
 private:
 	UA_Server             * m_server;
@@ -277,6 +396,69 @@ private:
 	quint16                 m_maxSessions;
 	UA_Boolean              m_running;
 	QTimer                  m_iterWaitTimer;
+	bool                    m_iterEventDriven;
+	QHash<qintptr, QSocketNotifier*> m_iterNotifiers;
+	// queued values written from any thread
+	struct QUaQueuedValue
+	{
+		UA_NodeId     nodeId;
+		UA_Variant    value;
+		UA_StatusCode status;
+		UA_DateTime   sourceTimestamp;
+	};
+	QMutex                  m_valueQueueMutex;
+	QVector<QUaQueuedValue> m_valueQueue;
+	// batched writes
+	int                     m_updateDepth;
+	quint32                 m_updateBatch; // incremented on each commit
+	bool                    m_updateCommitting;
+	QVector<UA_WriteValue>  m_updateWrites;
+	// polling scheduler, one timer per interval
+	struct QUaPollGroup
+	{
+		int                       timerId;
+		QVector<QUaBaseVariable*> variables;
+	};
+	struct QUaPollEntry
+	{
+		int interval;
+		int index;
+	};
+	std::function<QVariantList(const QVector<QUaBaseVariable*>&)> m_pollProvider;
+	QHash<int, QUaPollGroup>              m_pollGroups;  // by interval
+	QHash<int, int>                       m_pollTimers;  // timer id to interval
+	QHash<QUaBaseVariable*, QUaPollEntry> m_pollEntries;
+	// lite variables, free handles are reused
+	QVector<UA_NodeId> m_liteNodes;
+	QVector<int>       m_liteFree;
+	struct QUaLiteCallback
+	{
+		int handle;
+		std::function<void(const int&, const QVariant&)> callback;
+	};
+	QHash<QUaNodeId, QUaLiteCallback> m_liteCallbacks;
+	QHash<QUaNodeId, int>             m_liteHandles;
+	// release handle of lite variable node, no-op if not lite
+	void releaseLiteHandle(const UA_NodeId& nodeId);
+	bool m_liteCreating;
+	bool m_lazyInstantiation;
+	const QMetaObject* metaObjectByTypeId(const UA_NodeId& typeNodeId);
+	// instantiate all nodestore nodes of the type that have no C++ instance yet
+	void materializeTypeInstances(const QMetaObject& metaObject);
+	bool m_liteInternalWrite;
+	bool liteValueInternal   (const int& handle, UA_Variant& value) const;
+	bool setLiteValueInternal(const int& handle, const UA_Variant& value);
+	static void onLiteWrite(
+		UA_Server             *server, 
+		const UA_NodeId       *sessionId,
+		void                  *sessionContext, 
+		const UA_NodeId       *nodeId,
+		void                  *nodeContext, 
+		const UA_NumericRange *range,
+		const UA_DataValue    *data
+	);
+	bool                    m_iterThreaded;
+	QThread               * m_iterThread;
 	QByteArray              m_byteCertificate;
 	QByteArray              m_byteCertificateInternal; // NOTE : needs to exists as long as server instance
 	bool                    m_anonymousLoginAllowed;
@@ -305,8 +487,28 @@ private:
 	QHash<QUaReferenceType, UA_NodeId    > m_hashRefTypes;
 	QHash<QUaReferenceType, UA_NodeId    > m_hashHierRefTypes;
 	QHash<UA_NodeId       , QUaSignaler* > m_hashSignalers;
+	// index of bound c++ instances, updated on bind and on ~QUaNode
+	QHash<QUaNodeId       , QUaNode*     > m_hashNodes;
+	// browse names stored in nodes share string data, unused names pruned as table grows
+	QSet<QString> m_internedNames;
+	int           m_internedPrune;
+	QUaQualifiedName internBrowseName(const QUaQualifiedName& browseName);
+	// intrusive list of bound instances per type, updated on construct and destroy
+	struct QUaTypeInstances
+	{
+		QUaNode* first = nullptr;
+		QUaNode* last  = nullptr;
+		int      count = 0;
+	};
+	// NOTE : keyed by class name pointer, shared by copies of the meta object (e.g. in constructors)
+	QHash<const char*, QUaTypeInstances> m_hashTypeInstances;
+	void addTypeInstance   (QUaNode* node, const QMetaObject* metaObject);
+	void removeTypeInstance(QUaNode* node);
     // mandatory children browsenames for type definition
     QHash<QUaNodeId, QSet<QUaQualifiedName>> m_hashMandatoryChildren;
+    // ordered children browsenames to bind on instantiation (props first, then mandatory)
+    QHash<const QMetaObject*, QVector<QUaQualifiedName>> m_hashTypeLayouts;
+    const QVector<QUaQualifiedName>& typeLayout(const QMetaObject& metaObject, const UA_NodeId& nodeId);
 
 	QUaValidationCallback m_validationCallback;
 
@@ -320,8 +522,17 @@ private:
 #ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
     QUaSignaler m_changeEventSignaler;
 	QUaGeneralModelChangeEvent * m_changeEvent;
-	QUaChangesList m_listChanges; // buffer
+	QUaChangesList m_listChanges; // buffer, keeps insertion order
+	QSet<QUaChangeStructureDataType> m_setChanges; // buffer, fast lookup
+	bool          m_changesOverflow;
+	uchar         m_changesOverflowVerb;
+	int           m_changeMinInterval;
+	int           m_changeMaxCount;
+	QElapsedTimer m_changeLastEmit;
+	QTimer        m_changeEventTimer;
 	void addChange(const QUaChangeStructureDataType& change);
+	void scheduleChangeEvent();
+	void triggerChangeEvent();
     // mandatory and optional variable children browsenames for event type definition
     // need this to store historic events in a consistent way, ignoring manually added children
     QHash<QUaNodeId, QUaNode::QUaEventFieldMetaData> m_hashTypeVars;
@@ -347,6 +558,26 @@ private:
 
 	// reset open62541 config
 	void resetConfig();
+	// value ingestion
+	void queueValueInternal(
+		const QUaNodeId     &nodeId,
+		UA_Variant          &value,
+		const QUaStatusCode &statusCode,
+		const QDateTime     &sourceTimestamp
+	);
+	void processValueQueue();
+	// batch update, takes ownership of write value members
+	void addUpdateWrite(UA_WriteValue &writeValue);
+	// polling scheduler
+	void pollGroup(const int& interval);
+	// event driven iteration
+	void iterateOnEvent();
+	void updateSocketNotifiers();
+	void clearSocketNotifiers();
+	// dedicated thread iteration
+	void startIterateThread();
+	void stopIterateThread();
+	void moveServerToThread(QThread * thread);
 
 	// parse and validate certificate
 	static UA_ByteString * parseCertificate(const QByteArray &inByteCert, 
@@ -354,11 +585,17 @@ private:
 		                                    QByteArray       &outByteCert);
     void setupServer();
 	UA_Logger getLogger();
+	// browse
+	// first element of a browse path is ObjectsFolder or one of its children
+	QUaNode* browsePathRoot(const QUaQualifiedName& first) const;
+	static QUaBrowsePath browsePathFromString(const QString& strPath, const QString& separator);
 	// types
     template<typename T>
     void registerSpecificationType(const UA_NodeId& typeNodeId, const bool abstract = false);
 	void registerTypeInternal(const QMetaObject &metaObject, const QUaNodeId &nodeId = QUaNodeId());
 	QList<QUaNode*> typeInstances(const QMetaObject &metaObject);
+	// create C++ instance for a node already in the nodestore
+	QUaNode* instantiateNode(const UA_NodeId *nodeId, const QMetaObject &metaObject);
 	template<typename T, typename M>
 	QMetaObject::Connection instanceCreated(
 		const QMetaObject &metaObject,
@@ -379,6 +616,19 @@ private:
 	void addMetaMethods         (const QMetaObject &metaObject);
     UA_NodeId typeIdByMetaObject(const QMetaObject &metaObject);
 
+	// shared by createInstanceInternal and createInstancesInternal
+	bool isInstantiableType(const QMetaObject &metaObject) const;
+	UA_VariableAttributes typeVariableAttributes(const UA_NodeId &typeNodeId) const;
+	UA_NodeId addInstanceNode(
+		const QMetaObject           &metaObject,
+		QUaNode                     *parentNode,
+		const UA_NodeId             &referenceTypeId,
+		const UA_NodeId             &typeNodeId,
+		const UA_VariableAttributes *typeAttr,
+		const QUaQualifiedName      &browseName,
+		const UA_NodeId             &reqNodeId
+	);
+
 	UA_NodeId createInstanceInternal(
         const QMetaObject &metaObject, 
         QUaNode * parentNode, 
@@ -386,6 +636,13 @@ private:
         const QUaNodeId &nodeId
     );
 
+	QList<UA_NodeId> createInstancesInternal(
+        const QMetaObject &metaObject, 
+        QUaNode * parentNode, 
+        const int &count,
+        const std::function<QUaQualifiedName(const int&)> &nameGenerator
+    );
+
 #ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
 	// create instance of a given event type
 	UA_NodeId createEventInternal(
@@ -569,6 +826,7 @@ inline QList<T*> QUaServer::typeInstances()
 {
 	QList<T*> retList;
 	auto nodeList = this->typeInstances(T::staticMetaObject);
+	retList.reserve(nodeList.count());
 	for (int i = 0; i < nodeList.count(); i++)
 	{
 		auto instance = qobject_cast<T*>(nodeList.at(i));
@@ -578,6 +836,60 @@ inline QList<T*> QUaServer::typeInstances()
 	return retList;
 }
 
+template<typename T>
+inline T QUaServer::liteValue(const int& handle) const
+{
+	T retValue = T();
+	UA_Variant uaVar;
+	UA_Variant_init(&uaVar);
+	if (!this->liteValueInternal(handle, uaVar))
+	{
+		return retValue;
+	}
+	// arithmetic types with same layout are copied directly
+	if (std::is_arithmetic<T>::value && 
+		UA_Variant_hasScalarType(&uaVar, QUaTypesConverter::uaTypeFromCpp<T>()))
+	{
+		retValue = *static_cast<T*>(uaVar.data);
+	}
+	else
+	{
+		retValue = QUaTypesConverter::uaVariantToQVariant(uaVar).value<T>();
+	}
+	UA_Variant_clear(&uaVar);
+	return retValue;
+}
+
+template<typename T>
+inline bool QUaServer::setLiteValue(const int& handle, const T& value)
+{
+	UA_Variant uaVar = QUaTypesConverter::uaVariantFromCpp(value);
+	bool ok = this->setLiteValueInternal(handle, uaVar);
+	UA_Variant_clear(&uaVar);
+	return ok;
+}
+
+template<typename T, typename M>
+inline void QUaServer::forEachTypeInstance(const M &callback)
+{
+	this->materializeTypeInstances(T::staticMetaObject);
+	auto iter = m_hashTypeInstances.find(T::staticMetaObject.className());
+	if (iter == m_hashTypeInstances.end())
+	{
+		return;
+	}
+	QUaNode* node = iter.value().first;
+	while (node)
+	{
+		// get next in advance in case callback deletes current
+		QUaNode* next = node->m_typeNext;
+		auto instance = static_cast<T*>(node);
+		Q_ASSERT(qobject_cast<T*>(node));
+		callback(instance);
+		node = next;
+	}
+}
+
 template<typename T, typename M>
 inline QMetaObject::Connection QUaServer::instanceCreated(const M & callback)
 {
@@ -621,6 +933,18 @@ inline void QUaServer::registerSpecificationType(const UA_NodeId& typeNodeId, co
     this->registerTypeLifeCycle(typeNodeId, metaObject);
 }
 
+template<typename T>
+inline void QUaServer::queueValue(
+	const QUaNodeId     &nodeId,
+	const T             &value,
+	const QUaStatusCode &statusCode/* = QUaStatus::Good*/,
+	const QDateTime     &sourceTimestamp/* = QDateTime()*/)
+{
+	// NOTE : convert in producer thread, arithmetic types avoid QVariant
+	UA_Variant uaValue = QUaTypesConverter::uaVariantFromCpp<T>(value);
+	this->queueValueInternal(nodeId, uaValue, statusCode, sourceTimestamp);
+}
+
 template<typename T, typename M>
 inline QMetaObject::Connection QUaServer::instanceCreated(
 	const QMetaObject & metaObject, 
@@ -696,6 +1020,40 @@ inline T * QUaServer::createInstance(
 	return newInstance;
 }
 
+template<typename T>
+inline QList<T*> QUaServer::createInstances(
+    QUaNode * parentNode, 
+    const int &count,
+    const std::function<QUaQualifiedName(const int&)> &nameGenerator
+)
+{
+	QList<T*> retList;
+	// instantiate first in OPC UA
+	QList<UA_NodeId> newInstancesNodeIds = this->createInstancesInternal(
+        T::staticMetaObject, 
+        parentNode, 
+        count,
+        nameGenerator
+    );
+	retList.reserve(newInstancesNodeIds.count());
+	for (auto &newInstanceNodeId : newInstancesNodeIds)
+	{
+		// get new c++ instance created in UA constructor
+		auto tmp = QUaNode::getNodeContext(newInstanceNodeId, this->m_server);
+		T * newInstance = qobject_cast<T*>(tmp);
+		Q_CHECK_PTR(newInstance);
+		Q_ASSERT(newInstance->parent() == parentNode);
+		UA_NodeId_clear(&newInstanceNodeId);
+		if (!newInstance)
+		{
+			continue;
+		}
+		retList << newInstance;
+	}
+	// return c++ instances
+	return retList;
+}
+
 #ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
 template<typename T>
 inline T * QUaServer::createEvent()
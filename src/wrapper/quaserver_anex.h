@@ -421,6 +421,55 @@ void UA_WorkQueue_manuallyProcessDelayed(UA_WorkQueue * wq);
 /*********************************************************************************************
 Copied from open62541, to be able to implement:
 
+QUaServer::commitUpdate
+write all batched values with a single service call
+*/
+
+extern "C"
+void Service_Write(UA_Server * server, UA_Session * session,
+    const UA_WriteRequest * request,
+    UA_WriteResponse * response);
+
+/*********************************************************************************************
+Copied from open62541, to be able to implement:
+
+QUaBaseVariable::clearValueSource
+switch variable from data source back to stored value
+*/
+
+typedef UA_StatusCode (*UA_EditNodeCallback)(UA_Server*, UA_Session*,
+    UA_Node *node, void*);
+
+extern "C"
+UA_StatusCode UA_Server_editNode(UA_Server *server, UA_Session *session,
+    const UA_NodeId *nodeId, UA_EditNodeCallback callback,
+    void *data);
+
+/*********************************************************************************************
+Copied from open62541, to be able to implement:
+
+QUaServer::updateSocketNotifiers
+get listening and connection sockets of the TCP network layer
+*/
+
+typedef struct ConnectionEntry {
+    UA_Connection connection;
+    LIST_ENTRY(ConnectionEntry) pointers;
+} ConnectionEntry;
+
+typedef struct {
+    const UA_Logger* logger; // Set during start
+    UA_UInt16 port;
+    UA_UInt16 maxConnections;
+    UA_SOCKET serverSockets[FD_SETSIZE];
+    UA_UInt16 serverSocketsSize;
+    LIST_HEAD(, ConnectionEntry) connections;
+    UA_UInt16 connectionsSize;
+} ServerNetworkLayerTCP;
+
+/*********************************************************************************************
+Copied from open62541, to be able to implement:
+
 QUaServer::anonymousLoginAllowed
 QUaServer::setAnonymousLoginAllowed
 set AccessControlContext::allowAnonymous
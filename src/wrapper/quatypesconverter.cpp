@@ -1,5 +1,6 @@
 #include "quatypesconverter.h"
 #include <cstring>
+#include <limits>
 
 QT_BEGIN_NAMESPACE
 
@@ -951,6 +952,161 @@ inline QString listToString(const QList<T>& list, const QLatin1String& separator
 	return retString;
 }
 
+bool isArithmeticType(const UA_DataType * uaType)
+{
+	// NOTE : arithmetic types are contiguous in UA_TYPES, from UA_TYPES_BOOLEAN to UA_TYPES_DOUBLE
+	return uaType &&
+		uaType->typeIndex <= UA_TYPES_DOUBLE &&
+		uaType == &UA_TYPES[uaType->typeIndex];
+}
+
+bool isNumericType(const UA_DataType * uaType)
+{
+	return isArithmeticType(uaType) && 
+		uaType->typeIndex != UA_TYPES_BOOLEAN;
+}
+
+// if not floating point to integer, static_cast is well defined
+template<typename SRCTYPE, typename DSTTYPE>
+inline DSTTYPE uaNumericCast(const SRCTYPE & value, std::false_type)
+{
+	return static_cast<DSTTYPE>(value);
+}
+
+// if floating point to integer, out of range or NaN is undefined so saturate (NaN to zero)
+template<typename SRCTYPE, typename DSTTYPE>
+inline DSTTYPE uaNumericCast(const SRCTYPE & value, std::true_type)
+{
+	if (value != value)
+	{
+		return DSTTYPE(0);
+	}
+	// NOTE : limits converted to SRCTYPE can round up, so use inclusive comparisons
+	if (value <= static_cast<SRCTYPE>(std::numeric_limits<DSTTYPE>::lowest()))
+	{
+		return std::numeric_limits<DSTTYPE>::lowest();
+	}
+	if (value >= static_cast<SRCTYPE>(std::numeric_limits<DSTTYPE>::max()))
+	{
+		return std::numeric_limits<DSTTYPE>::max();
+	}
+	return static_cast<DSTTYPE>(value);
+}
+
+template<typename SRCTYPE, typename DSTTYPE>
+void uaNumericArrayCast(const void * src, void * dst, const size_t & size)
+{
+	// NOTE : plain loop with inlined conversion, compiler can vectorize it
+	auto srcArr = static_cast<const SRCTYPE *>(src);
+	auto dstArr = static_cast<DSTTYPE *>(dst);
+	using saturate = std::integral_constant<bool,
+		std::is_floating_point<SRCTYPE>::value &&
+		std::is_integral<DSTTYPE>::value &&
+		!std::is_same<DSTTYPE, UA_Boolean>::value>;
+	for (size_t i = 0; i < size; i++)
+	{
+		dstArr[i] = uaNumericCast<SRCTYPE, DSTTYPE>(srcArr[i], saturate());
+	}
+}
+
+template<typename DSTTYPE>
+void uaNumericArrayCast(const void * src, const UA_DataType * srcType, void * dst, const size_t & size)
+{
+	switch (srcType->typeIndex)
+	{
+	case UA_TYPES_BOOLEAN:
+		return uaNumericArrayCast<UA_Boolean, DSTTYPE>(src, dst, size);
+	case UA_TYPES_SBYTE:
+		return uaNumericArrayCast<UA_SByte  , DSTTYPE>(src, dst, size);
+	case UA_TYPES_BYTE:
+		return uaNumericArrayCast<UA_Byte   , DSTTYPE>(src, dst, size);
+	case UA_TYPES_INT16:
+		return uaNumericArrayCast<UA_Int16  , DSTTYPE>(src, dst, size);
+	case UA_TYPES_UINT16:
+		return uaNumericArrayCast<UA_UInt16 , DSTTYPE>(src, dst, size);
+	case UA_TYPES_INT32:
+		return uaNumericArrayCast<UA_Int32  , DSTTYPE>(src, dst, size);
+	case UA_TYPES_UINT32:
+		return uaNumericArrayCast<UA_UInt32 , DSTTYPE>(src, dst, size);
+	case UA_TYPES_INT64:
+		return uaNumericArrayCast<UA_Int64  , DSTTYPE>(src, dst, size);
+	case UA_TYPES_UINT64:
+		return uaNumericArrayCast<UA_UInt64 , DSTTYPE>(src, dst, size);
+	case UA_TYPES_FLOAT:
+		return uaNumericArrayCast<UA_Float  , DSTTYPE>(src, dst, size);
+	case UA_TYPES_DOUBLE:
+		return uaNumericArrayCast<UA_Double , DSTTYPE>(src, dst, size);
+	default:
+		Q_ASSERT(false);
+		break;
+	}
+}
+
+bool uaNumericArrayCopy(
+	const void        * src, 
+	const UA_DataType * srcType, 
+	void              * dst, 
+	const UA_DataType * dstType, 
+	const size_t      & size)
+{
+	if (!isArithmeticType(srcType) || !isArithmeticType(dstType))
+	{
+		return false;
+	}
+	if (size == 0)
+	{
+		return true;
+	}
+	// same type, copy all at once
+	// NOTE : values are stored in host byte order, swapping only happens on binary encoding
+	if (srcType == dstType)
+	{
+		std::memcpy(dst, src, size * srcType->memSize);
+		return true;
+	}
+	// different type, widen or narrow each element
+	switch (dstType->typeIndex)
+	{
+	case UA_TYPES_BOOLEAN:
+		uaNumericArrayCast<UA_Boolean>(src, srcType, dst, size);
+		break;
+	case UA_TYPES_SBYTE:
+		uaNumericArrayCast<UA_SByte  >(src, srcType, dst, size);
+		break;
+	case UA_TYPES_BYTE:
+		uaNumericArrayCast<UA_Byte   >(src, srcType, dst, size);
+		break;
+	case UA_TYPES_INT16:
+		uaNumericArrayCast<UA_Int16  >(src, srcType, dst, size);
+		break;
+	case UA_TYPES_UINT16:
+		uaNumericArrayCast<UA_UInt16 >(src, srcType, dst, size);
+		break;
+	case UA_TYPES_INT32:
+		uaNumericArrayCast<UA_Int32  >(src, srcType, dst, size);
+		break;
+	case UA_TYPES_UINT32:
+		uaNumericArrayCast<UA_UInt32 >(src, srcType, dst, size);
+		break;
+	case UA_TYPES_INT64:
+		uaNumericArrayCast<UA_Int64  >(src, srcType, dst, size);
+		break;
+	case UA_TYPES_UINT64:
+		uaNumericArrayCast<UA_UInt64 >(src, srcType, dst, size);
+		break;
+	case UA_TYPES_FLOAT:
+		uaNumericArrayCast<UA_Float  >(src, srcType, dst, size);
+		break;
+	case UA_TYPES_DOUBLE:
+		uaNumericArrayCast<UA_Double >(src, srcType, dst, size);
+		break;
+	default:
+		Q_ASSERT(false);
+		return false;
+	}
+	return true;
+}
+
 template<typename T>
 inline QList<T> stringToList(const QString& string, const QLatin1String& separator = QLatin1String(","))
 {
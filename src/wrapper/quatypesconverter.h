@@ -27,6 +27,14 @@ namespace QUaTypesConverter {
 	// qt from c++
 	template<typename T>
 	QMetaType::Type qtTypeFromCpp();
+	// ua from c++ : arithmetic types are copied directly, others converted through QVariant
+	template<typename T>
+	UA_Variant uaVariantFromCpp(const T &value);
+	// ua from c++ : arrays of arithmetic types are copied directly, others converted through QVariant
+	template<typename T>
+	UA_Variant uaVariantFromCpp(const QVector<T> &value);
+	template<typename T>
+	UA_Variant uaVariantFromCpp(const QList<T> &value);
 	// ua from qt
 	UA_NodeId          uaTypeNodeIdFromQType(const QMetaType::Type &type);
 	const UA_DataType *uaTypeFromQType      (const QMetaType::Type &type);
@@ -70,6 +78,16 @@ namespace QUaTypesConverter {
 	QVariant uaVariantToQVariantVector(const UA_Variant &uaVariant);
     template <typename ARRAYTYPE, typename UATYPE>
 	QVariant uaVariantToQVariantArray (const UA_Variant &var, QMetaType::Type type);
+	// contiguous arithmetic arrays (boolean, integers, float and double)
+	bool isArithmeticType(const UA_DataType *uaType);
+	// same but without boolean (e.g. for deadband)
+	bool isNumericType(const UA_DataType *uaType);
+	// copy size elements, single memcpy if same type, else element-wise cast to dstType
+	bool uaNumericArrayCopy(const void        *src, 
+		                    const UA_DataType *srcType, 
+		                    void              *dst, 
+		                    const UA_DataType *dstType, 
+		                    const size_t      &size);
 
 	template<typename T>
 	UA_NodeId uaTypeNodeIdFromCpp()
@@ -287,6 +305,119 @@ namespace QUaTypesConverter {
 		return QMetaType::UnknownType;
 	}
 
+	// index in UA_TYPES with same memory layout as arithmetic T, -1 if not arithmetic
+	// NOTE : select by size and sign, not by qt metatype (e.g. long is 4 bytes on Windows)
+	template<typename T>
+	constexpr int uaTypeIndexFromCpp()
+	{
+		return !std::is_arithmetic<T>::value ? -1 :
+			std::is_same<T, bool>::value ? UA_TYPES_BOOLEAN :
+			std::is_floating_point<T>::value ? 
+				(sizeof(T) == 4 ? UA_TYPES_FLOAT : sizeof(T) == 8 ? UA_TYPES_DOUBLE : -1) :
+			sizeof(T) == 1 ? (std::is_signed<T>::value ? UA_TYPES_SBYTE : UA_TYPES_BYTE  ) :
+			sizeof(T) == 2 ? (std::is_signed<T>::value ? UA_TYPES_INT16 : UA_TYPES_UINT16) :
+			sizeof(T) == 4 ? (std::is_signed<T>::value ? UA_TYPES_INT32 : UA_TYPES_UINT32) :
+			sizeof(T) == 8 ? (std::is_signed<T>::value ? UA_TYPES_INT64 : UA_TYPES_UINT64) :
+			-1;
+	}
+
+	// ua type with same memory layout as arithmetic T, null if none
+	template<typename T>
+	const UA_DataType * uaTypeFromCpp()
+	{
+		const int index = uaTypeIndexFromCpp<T>();
+		const UA_DataType * type = index >= 0 ? &UA_TYPES[index] : nullptr;
+		Q_ASSERT(!type || type->memSize == sizeof(T));
+		return type;
+	}
+
+	// if T arithmetic
+	template<typename T>
+	UA_Variant uaVariantFromCppInternal(const T &value, std::true_type)
+	{
+		UA_Variant uaVar;
+		UA_Variant_init(&uaVar);
+		auto st = UA_Variant_setScalarCopy(&uaVar, &value, uaTypeFromCpp<T>());
+		Q_ASSERT(st == UA_STATUSCODE_GOOD);
+		Q_UNUSED(st);
+		return uaVar;
+	}
+
+	// if T not arithmetic
+	template<typename T>
+	UA_Variant uaVariantFromCppInternal(const T &value, std::false_type)
+	{
+		return uaVariantFromQVariant(QVariant::fromValue(value));
+	}
+
+	template<typename T>
+	UA_Variant uaVariantFromCpp(const T &value)
+	{
+		return uaVariantFromCppInternal(value, std::is_arithmetic<T>());
+	}
+
+	// set array dimensions same as uaVariantFromQVariantArray
+	inline void uaVariantSetArrayDimensions(UA_Variant &uaVar, const size_t &size)
+	{
+		uaVar.arrayDimensions     = static_cast<UA_UInt32 *>(UA_Array_new(1, &UA_TYPES[UA_TYPES_UINT32]));
+		uaVar.arrayDimensions[0]  = static_cast<UA_UInt32>(size);
+		uaVar.arrayDimensionsSize = static_cast<size_t>(1);
+	}
+
+	// if T arithmetic, QVector data is contiguous so copy all at once
+	template<typename T>
+	UA_Variant uaVariantFromCppArray(const QVector<T> &value, std::true_type)
+	{
+		UA_Variant uaVar;
+		UA_Variant_init(&uaVar);
+		if (value.isEmpty())
+		{
+			return uaVar;
+		}
+		auto st = UA_Variant_setArrayCopy(&uaVar, value.constData(), static_cast<size_t>(value.size()), uaTypeFromCpp<T>());
+		Q_ASSERT(st == UA_STATUSCODE_GOOD);
+		Q_UNUSED(st);
+		uaVariantSetArrayDimensions(uaVar, static_cast<size_t>(value.size()));
+		return uaVar;
+	}
+
+	// if T arithmetic, QList data is not contiguous so copy element by element
+	template<typename T>
+	UA_Variant uaVariantFromCppArray(const QList<T> &value, std::true_type)
+	{
+		UA_Variant uaVar;
+		UA_Variant_init(&uaVar);
+		if (value.isEmpty())
+		{
+			return uaVar;
+		}
+		const UA_DataType * type = uaTypeFromCpp<T>();
+		T *arr = static_cast<T *>(UA_Array_new(static_cast<size_t>(value.size()), type));
+		std::copy(value.cbegin(), value.cend(), arr);
+		UA_Variant_setArray(&uaVar, arr, static_cast<size_t>(value.size()), type);
+		uaVariantSetArrayDimensions(uaVar, static_cast<size_t>(value.size()));
+		return uaVar;
+	}
+
+	// if T not arithmetic
+	template<typename C>
+	UA_Variant uaVariantFromCppArray(const C &value, std::false_type)
+	{
+		return uaVariantFromQVariant(QVariant::fromValue(value));
+	}
+
+	template<typename T>
+	UA_Variant uaVariantFromCpp(const QVector<T> &value)
+	{
+		return uaVariantFromCppArray(value, std::is_arithmetic<T>());
+	}
+
+	template<typename T>
+	UA_Variant uaVariantFromCpp(const QList<T> &value)
+	{
+		return uaVariantFromCppArray(value, std::is_arithmetic<T>());
+	}
+
 	void registerCustomTypes();
 }
 